@@ -42,6 +42,10 @@ namespace yart
             yart::Backend::PollEvents();
             yart::Interface::HandleInputs();
 
+            // Hand the scene edits made last frame over to the renderer as a new scene version, without waiting for in-flight frames. 
+            // Published before the UI is rendered, so that the viewports' frame requests resetting the image for the edits also carry them
+            m_scene->Publish();
+
             // Begin recording a new frame
             yart::Backend::NewFrame();
 
@@ -53,6 +57,7 @@ namespace yart
         }
 
         // -- APPLICATION EXIT SEQUENCE -- // 
+        m_renderer->StopRenderThread();
         yart::Interface::Shutdown();
         yart::Backend::Close();
         return EXIT_SUCCESS;
@@ -71,6 +76,7 @@ namespace yart
         // Load the default scene
         m_renderer->SetScene(m_scene);
         m_scene->LoadDefault();
+        m_scene->Publish();
 
         return true;
     }
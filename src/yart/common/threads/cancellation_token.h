@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the CancellationToken class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <atomic>
+
+
+namespace yart
+{
+    namespace threads
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Flag for cooperative cancellation of long running work
+        /// @details The work is not interrupted, instead it is expected to poll the token at regular points
+        ///     (e.g. once per processed tile) and stop early once it has been cancelled
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class CancellationToken {
+        public:
+            /// @brief Request cancellation of the work observing the token. Safe to call from any thread
+            void Cancel()
+            {
+                m_cancelled.store(true, std::memory_order_relaxed);
+            }
+
+            /// @brief Clear a previous cancellation request, before the token is reused for new work
+            void Reset()
+            {
+                m_cancelled.store(false, std::memory_order_relaxed);
+            }
+
+            /// @brief Check whether cancellation has been requested. Safe to call from any thread
+            /// @return Whether the work observing the token should stop
+            bool IsCancelled() const
+            {
+                return m_cancelled.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<bool> m_cancelled { false }; ///< Whether cancellation has been requested
+
+        };
+
+    } // namespace threads
+} // namespace yart
@@ -6,56 +6,95 @@
 #pragma once
 
 
-#include <functional>
-#include <vector>
-#include <future>
+#include <algorithm>
+#include <cstdint>
+
+#include "thread_pool.h"
+#include "tile_scheduler.h"
 
 
 namespace yart
 {
     namespace threads
     {
-        /// @brief Parallelized for-loop using std futures
+        /// @brief Parallelized for-loop over blocked ranges, executed on the global thread pool
+        /// @details The range is split into a few blocks per pool thread, which are pulled dynamically by the threads
         /// @tparam T Numeric type of the iterable
+        /// @tparam F Callable type with a `void(T block_begin, T block_end)` signature
         /// @param begin Range start value
-        /// @param end Range end value (inclusive)
+        /// @param end Range end value (exclusive)
+        /// @param func Function applied over each block of the range
+        template<typename T, typename F>
+        void parallel_for_blocked(T begin, T end, const F& func)
+        {
+            static constexpr uint32_t BLOCKS_PER_THREAD = 4; // Oversubscription factor, balancing out uneven per-item costs
+
+            if (end <= begin)
+                return;
+
+            ThreadPool& pool = ThreadPool::Get();
+
+            const T length = end - begin;
+            const T block_count = std::min<T>(length, static_cast<T>(pool.GetThreadCount() * BLOCKS_PER_THREAD));
+            const T block_size = length / block_count;
+            const T remainder = length % block_count;
+
+            pool.Run(static_cast<uint32_t>(block_count), [&](uint32_t block) {
+                // The first `remainder` blocks process one extra item
+                const T b = static_cast<T>(block);
+                const T start = begin + b * block_size + std::min(b, remainder);
+                const T stop = start + block_size + (b < remainder ? 1 : 0);
+
+                func(start, stop);
+            });
+        }
+
+        /// @brief Parallelized for-loop, executed on the global thread pool
+        /// @tparam T Numeric type of the iterable
+        /// @tparam F Callable type with a `void(T i)` signature
+        /// @param begin Range start value
+        /// @param end Range end value (exclusive)
         /// @param func Function applied over the range
-        template<typename T>
-        void parallel_for(T begin, T end, std::function<void(T)> func)
+        template<typename T, typename F>
+        void parallel_for(T begin, T end, const F& func)
         {
-            // Internal wrapper function
-            auto wrapper = [&func](T _begin, T _end) {
-                for (T i = _begin; i < _end; ++i) {
+            parallel_for_blocked(begin, end, [&](T block_begin, T block_end) {
+                for (T i = block_begin; i < block_end; ++i) {
                     func(i);
                 }
-            };
-
-            uint32_t thread_num_hint = std::thread::hardware_concurrency();
-            int thread_num = thread_num_hint ? static_cast<int>(thread_num_hint) : 8;
+            });
+        }
 
-            T length = end - begin;
-            const auto [batch_size, remainder] = std::div(length, thread_num);
+        /// @brief Parallelized two-dimensional loop over square blocks, balanced between the threads with a work-stealing TileScheduler
+        /// @tparam F Callable type with a `void(const yart::threads::Tile& block)` signature
+        /// @param width Number of columns in the range
+        /// @param height Number of rows in the range
+        /// @param block_size Width and height of the blocks
+        /// @param func Function applied over each block of the range
+        template<typename F>
+        void parallel_for_2d_blocked(uint32_t width, uint32_t height, uint32_t block_size, const F& func)
+        {
+            TileScheduler scheduler(width, height, block_size);
+            scheduler.Run(func);
+        }
 
-            // launch threads
-            std::vector<std::future<void>> threads(thread_num);
-            if (remainder) {
-                for(size_t i = 0; i < thread_num - 1; ++i) {
-                    T start = begin + i * batch_size;
-                    threads[i] = std::async(std::launch::async, wrapper, start, start + batch_size);
-                }
+        /// @brief Parallelized two-dimensional loop, processed in square blocks
+        /// @tparam F Callable type with a `void(uint32_t x, uint32_t y)` signature
+        /// @param width Number of columns in the range
+        /// @param height Number of rows in the range
+        /// @param func Function applied over each `(x, y)` element of the range
+        template<typename F>
+        void parallel_for_2d(uint32_t width, uint32_t height, const F& func)
+        {
+            static constexpr uint32_t BLOCK_SIZE = 32;
 
-                // Process the last segment with the remainder
-                T start = begin + (thread_num - 1) * batch_size;
-                threads[thread_num - 1] = std::async(std::launch::async, wrapper, start, end);
-            } else {
-                for(size_t i = 0; i < thread_num; ++i) {
-                    T start = begin + i * batch_size;
-                    threads[i] = std::async(std::launch::async, wrapper, start, start + batch_size);
+            parallel_for_2d_blocked(width, height, BLOCK_SIZE, [&](const Tile& block) {
+                for (uint32_t y = block.y0; y < block.y1; ++y) {
+                    for (uint32_t x = block.x0; x < block.x1; ++x) {
+                        func(x, y);
+                    }
                 }
-            }
-            
-            for (auto& thread : threads)
-                thread.get();
+            });
         }
 
     } // namespace threads
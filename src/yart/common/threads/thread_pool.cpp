@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of the ThreadPool class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "thread_pool.h"
+
+
+namespace yart
+{
+    namespace threads
+    {
+        /// @brief Whether the current thread is executing tasks of a pool job
+        static thread_local bool s_insideJob = false;
+
+
+        ThreadPool& ThreadPool::Get()
+        {
+            static const uint32_t thread_num_hint = std::thread::hardware_concurrency();
+
+            // The dispatching thread takes part in executing jobs, so one less worker is spawned
+            static ThreadPool pool(thread_num_hint ? thread_num_hint - 1 : 7);
+
+            return pool;
+        }
+
+        ThreadPool::ThreadPool(uint32_t worker_count)
+        {
+            m_workers.reserve(worker_count);
+            for (uint32_t i = 0; i < worker_count; ++i)
+                m_workers.emplace_back(&ThreadPool::WorkerMain, this);
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_shouldStop = true;
+            }
+
+            m_wakeCondition.notify_all();
+            for (auto& worker : m_workers)
+                worker.join();
+        }
+
+        void ThreadPool::Run(uint32_t task_count, TaskFunction func, const void* context)
+        {
+            if (task_count == 0)
+                return;
+
+            // Nested jobs would deadlock waiting for busy workers, so they are executed in place
+            if (s_insideJob || m_workers.empty() || task_count == 1) {
+                for (uint32_t i = 0; i < task_count; ++i)
+                    func(context, i);
+
+                return;
+            }
+
+            std::lock_guard<std::mutex> dispatch_lock(m_dispatchMutex);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_taskFunction = func;
+                m_taskContext = context;
+                m_taskCount = task_count;
+                m_nextTask.store(0, std::memory_order_relaxed);
+                m_busyWorkers = static_cast<uint32_t>(m_workers.size());
+                ++m_generation;
+            }
+
+            m_wakeCondition.notify_all();
+
+            s_insideJob = true;
+            ExecuteTasks();
+            s_insideJob = false;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_doneCondition.wait(lock, [this] { return m_busyWorkers == 0; });
+        }
+
+        void ThreadPool::WorkerMain()
+        {
+            s_insideJob = true;
+
+            uint64_t generation = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wakeCondition.wait(lock, [&] { return m_shouldStop || m_generation != generation; });
+
+                    if (m_shouldStop)
+                        return;
+
+                    generation = m_generation;
+                }
+
+                ExecuteTasks();
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_busyWorkers == 0)
+                    m_doneCondition.notify_one();
+            }
+        }
+
+        void ThreadPool::ExecuteTasks()
+        {
+            uint32_t task;
+            while ((task = m_nextTask.fetch_add(1, std::memory_order_relaxed)) < m_taskCount)
+                m_taskFunction(m_taskContext, task);
+        }
+
+    } // namespace threads
+} // namespace yart
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the ThreadPool class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <condition_variable>
+#include <cstdint>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+
+
+namespace yart
+{
+    namespace threads
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Pool of persistent worker threads, parked between dispatched jobs
+        /// @details A job is a number of indexed tasks, which are pulled by the workers and the dispatching
+        ///     thread from a shared atomic counter until the job is exhausted. Jobs dispatched from within
+        ///     a running task are executed serially on the calling thread
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class ThreadPool {
+        public:
+            /// @brief Type of the function executed for each task of a job
+            using TaskFunction = void(*)(const void* context, uint32_t task);
+
+            /// @brief Get the process-wide thread pool instance, with one thread per hardware thread
+            /// @return Global ThreadPool instance
+            static ThreadPool& Get();
+
+            /// @brief ThreadPool class constructor
+            /// @param worker_count Number of spawned worker threads, excluding the dispatching thread
+            ThreadPool(uint32_t worker_count);
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(ThreadPool const&) = delete;
+
+            /// @brief ThreadPool class destructor, stopping and joining all worker threads
+            ~ThreadPool();
+
+            /// @brief Get the number of threads executing dispatched jobs, including the dispatching thread
+            /// @return Thread count
+            uint32_t GetThreadCount() const
+            {
+                return static_cast<uint32_t>(m_workers.size()) + 1;
+            }
+
+            /// @brief Execute a job on all pool threads and block until all of its tasks are finished
+            /// @tparam F Callable type with a `void(uint32_t task)` signature
+            /// @param task_count Number of tasks in the job
+            /// @param func Function called once for each task index in the `[0, task_count)` range
+            template<typename F>
+            void Run(uint32_t task_count, const F& func)
+            {
+                auto invoke = [](const void* context, uint32_t task) {
+                    (*static_cast<const F*>(context))(task);
+                };
+
+                Run(task_count, invoke, &func);
+            }
+
+            /// @brief Execute a job on all pool threads and block until all of its tasks are finished
+            /// @param task_count Number of tasks in the job
+            /// @param func Function called once for each task index in the `[0, task_count)` range
+            /// @param context User data pointer passed to `func`
+            void Run(uint32_t task_count, TaskFunction func, const void* context);
+
+        private:
+            /// @brief Main loop of the worker threads
+            void WorkerMain();
+
+            /// @brief Pull and execute tasks of the current job until none are left
+            void ExecuteTasks();
+
+        private:
+            std::vector<std::thread> m_workers; ///< Worker threads owned by the pool
+
+            std::mutex m_dispatchMutex; ///< Mutex serializing jobs dispatched concurrently from different threads
+            std::mutex m_mutex; ///< Mutex guarding the job state shared with the workers
+            std::condition_variable m_wakeCondition; ///< Condition variable on which idle workers are parked
+            std::condition_variable m_doneCondition; ///< Condition variable notified when the last worker finishes a job
+
+            uint64_t m_generation = 0; ///< Counter of dispatched jobs, used by workers to detect a new job
+            uint32_t m_busyWorkers = 0; ///< Number of workers still executing the current job
+            bool m_shouldStop = false; ///< Whether the workers should exit
+
+            TaskFunction m_taskFunction = nullptr; ///< Task function of the current job
+            const void* m_taskContext = nullptr; ///< User data pointer of the current job
+            uint32_t m_taskCount = 0; ///< Number of tasks in the current job
+            std::atomic<uint32_t> m_nextTask { 0 }; ///< Index of the next task to be pulled from the current job
+
+        };
+
+    } // namespace threads
+} // namespace yart
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of the TileScheduler class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tile_scheduler.h"
+
+
+#include <algorithm>
+
+#include "yart/common/utils/yart_utils.h"
+
+
+namespace yart
+{
+    namespace threads
+    {
+        /// @brief Pack a range of tile indices into a single 64-bit word
+        static uint64_t PackRange(uint32_t begin, uint32_t end)
+        {
+            return static_cast<uint64_t>(begin) | (static_cast<uint64_t>(end) << 32);
+        }
+
+        /// @brief Unpack a range of tile indices from a 64-bit word
+        static void UnpackRange(uint64_t range, uint32_t* begin, uint32_t* end)
+        {
+            *begin = static_cast<uint32_t>(range);
+            *end = static_cast<uint32_t>(range >> 32);
+        }
+
+
+        TileScheduler::TileScheduler(uint32_t width, uint32_t height, uint32_t tile_size)
+            : m_tileSize(tile_size), m_width(width), m_height(height)
+        {
+            YART_ASSERT(tile_size > 0);
+
+            m_tilesX = (width + tile_size - 1) / tile_size;
+            m_tilesY = (height + tile_size - 1) / tile_size;
+
+            // Enumerate the tile grid in Z-order, skipping codes which fall outside of non-square or non-power-of-two grids
+            const uint32_t tile_count = GetTileCount();
+            m_tileOrder.reserve(tile_count);
+            for (uint32_t code = 0; m_tileOrder.size() < tile_count; ++code) {
+                uint32_t x, y;
+                MortonDecode(code, &x, &y);
+                if (x < m_tilesX && y < m_tilesY)
+                    m_tileOrder.push_back(y * m_tilesX + x);
+            }
+        }
+
+        Tile TileScheduler::GetTile(uint32_t index) const
+        {
+            YART_ASSERT(index < GetTileCount());
+
+            const uint32_t grid_index = m_tileOrder[index];
+
+            Tile tile;
+            tile.x0 = (grid_index % m_tilesX) * m_tileSize;
+            tile.y0 = (grid_index / m_tilesX) * m_tileSize;
+            tile.x1 = std::min(tile.x0 + m_tileSize, m_width);
+            tile.y1 = std::min(tile.y0 + m_tileSize, m_height);
+
+            return tile;
+        }
+
+        void TileScheduler::Distribute(uint32_t queue_count)
+        {
+            if (queue_count > m_queueCount) {
+                m_queues = std::make_unique<Queue[]>(queue_count);
+                m_queueCount = queue_count;
+            }
+
+            // Queues beyond `queue_count` are left over from earlier runs and must not hold any tiles
+            const uint32_t tile_count = GetTileCount();
+            for (uint32_t i = 0; i < m_queueCount; ++i) {
+                const uint32_t begin = i < queue_count ? static_cast<uint32_t>(static_cast<uint64_t>(tile_count) * i / queue_count) : tile_count;
+                const uint32_t end = i < queue_count ? static_cast<uint32_t>(static_cast<uint64_t>(tile_count) * (i + 1) / queue_count) : tile_count;
+                m_queues[i].range.store(PackRange(begin, end), std::memory_order_relaxed);
+            }
+        }
+
+        bool TileScheduler::PopTile(uint32_t queue, uint32_t* tile)
+        {
+            std::atomic<uint64_t>& range = m_queues[queue].range;
+
+            uint64_t value = range.load(std::memory_order_relaxed);
+            while (true) {
+                uint32_t begin, end;
+                UnpackRange(value, &begin, &end);
+                if (begin >= end)
+                    return false;
+
+                if (range.compare_exchange_weak(value, PackRange(begin + 1, end), std::memory_order_relaxed)) {
+                    *tile = begin;
+                    return true;
+                }
+            }
+        }
+
+        bool TileScheduler::StealTiles(uint32_t queue, uint32_t* tile)
+        {
+            while (true) {
+                // Pick the victim with the most remaining tiles
+                uint32_t victim = queue;
+                uint32_t victim_size = 0;
+                uint64_t victim_value = 0;
+                for (uint32_t i = 0; i < m_queueCount; ++i) {
+                    const uint64_t value = m_queues[i].range.load(std::memory_order_relaxed);
+
+                    uint32_t begin, end;
+                    UnpackRange(value, &begin, &end);
+                    if (i != queue && end > begin && end - begin > victim_size) {
+                        victim = i;
+                        victim_size = end - begin;
+                        victim_value = value;
+                    }
+                }
+
+                if (victim_size == 0)
+                    return false;
+
+                uint32_t begin, end;
+                UnpackRange(victim_value, &begin, &end);
+                const uint32_t split = end - (victim_size + 1) / 2;
+
+                if (!m_queues[victim].range.compare_exchange_strong(victim_value, PackRange(begin, split), std::memory_order_relaxed))
+                    continue; // The victim queue has changed in the meantime, retry
+
+                // The thief queue is empty, so no other thread can be modifying it concurrently
+                m_queues[queue].range.store(PackRange(split + 1, end), std::memory_order_relaxed);
+                *tile = split;
+                return true;
+            }
+        }
+
+    } // namespace threads
+} // namespace yart
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the TileScheduler class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <atomic>
+
+#include "thread_pool.h"
+
+
+namespace yart
+{
+    namespace threads
+    {
+        /// @brief Interleave the bits of two 16-bit coordinates into a Morton (Z-order) code
+        /// @param x Horizontal coordinate, stored in the even bits
+        /// @param y Vertical coordinate, stored in the odd bits
+        /// @return Morton code
+        inline uint32_t MortonEncode(uint32_t x, uint32_t y)
+        {
+            auto spread = [](uint32_t v) {
+                v &= 0x0000FFFF;
+                v = (v | (v << 8)) & 0x00FF00FF;
+                v = (v | (v << 4)) & 0x0F0F0F0F;
+                v = (v | (v << 2)) & 0x33333333;
+                v = (v | (v << 1)) & 0x55555555;
+                return v;
+            };
+
+            return spread(x) | (spread(y) << 1);
+        }
+
+        /// @brief Split a Morton (Z-order) code back into its two coordinates
+        /// @param code Morton code
+        /// @param x Output parameter set to the horizontal coordinate
+        /// @param y Output parameter set to the vertical coordinate
+        inline void MortonDecode(uint32_t code, uint32_t* x, uint32_t* y)
+        {
+            auto compact = [](uint32_t v) {
+                v &= 0x55555555;
+                v = (v | (v >> 1)) & 0x33333333;
+                v = (v | (v >> 2)) & 0x0F0F0F0F;
+                v = (v | (v >> 4)) & 0x00FF00FF;
+                v = (v | (v >> 8)) & 0x0000FFFF;
+                return v;
+            };
+
+            *x = compact(code);
+            *y = compact(code >> 1);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Rectangular region of an image
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct Tile {
+            uint32_t x0; ///< Horizontal coordinate of the first pixel column in the tile
+            uint32_t y0; ///< Vertical coordinate of the first pixel row in the tile
+            uint32_t x1; ///< Horizontal coordinate one past the last pixel column in the tile
+            uint32_t y1; ///< Vertical coordinate one past the last pixel row in the tile
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Work-stealing scheduler, processing image tiles on the global thread pool
+        /// @details Every participating thread owns a queue with a contiguous range of tiles, consumed from the front.
+        ///     Threads which run out of tiles steal the back half of the largest remaining queue,
+        ///     so the load is balanced dynamically while neighbouring tiles mostly stay on the same thread. 
+        ///     Tiles are enumerated in Morton (Z-order), so that every contiguous range of tiles covers a compact image region
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class TileScheduler {
+        public:
+            /// @brief TileScheduler class constructor
+            /// @param width Width in pixels of the image
+            /// @param height Height in pixels of the image
+            /// @param tile_size Width and height in pixels of the tiles. Tiles along the right and bottom image edges may be smaller
+            TileScheduler(uint32_t width, uint32_t height, uint32_t tile_size);
+
+            /// @brief Get the total number of tiles in the image
+            /// @return Tile count
+            uint32_t GetTileCount() const
+            {
+                return m_tilesX * m_tilesY;
+            }
+
+            /// @brief Get a tile of the image by its index
+            /// @param index Tile index, in Morton order
+            /// @return Image tile
+            Tile GetTile(uint32_t index) const;
+
+            /// @brief Process all image tiles in parallel and block until finished
+            /// @tparam F Callable type with a `void(const yart::threads::Tile& tile)` signature
+            /// @param func Function called once for each image tile
+            template<typename F>
+            void Run(const F& func)
+            {
+                const uint32_t tile_count = GetTileCount();
+                if (tile_count == 0)
+                    return;
+
+                ThreadPool& pool = ThreadPool::Get();
+                const uint32_t queue_count = pool.GetThreadCount() < tile_count ? pool.GetThreadCount() : tile_count;
+                Distribute(queue_count);
+
+                pool.Run(queue_count, [&](uint32_t queue) {
+                    uint32_t tile;
+                    while (PopTile(queue, &tile) || StealTiles(queue, &tile))
+                        func(GetTile(tile));
+                });
+            }
+
+        private:
+            /// @brief Split all tiles into contiguous ranges of equal size, one per queue
+            /// @param queue_count Number of queues
+            void Distribute(uint32_t queue_count);
+
+            /// @brief Take the first tile from a queue
+            /// @param queue Index of the queue
+            /// @param tile Output parameter set to the taken tile index
+            /// @return Whether the queue was not empty and a tile has been taken
+            bool PopTile(uint32_t queue, uint32_t* tile);
+
+            /// @brief Move the back half of the largest remaining queue into an empty queue and take its first tile
+            /// @param queue Index of the empty thief queue
+            /// @param tile Output parameter set to the taken tile index
+            /// @return Whether any tiles were left to steal and a tile has been taken
+            bool StealTiles(uint32_t queue, uint32_t* tile);
+
+        private:
+            ////////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Range of tile indices owned by a single thread
+            /// @details The `[begin, end)` range is packed into a single 64-bit word, with `begin` in the low bits,
+            ///     so that the owner and thieves can update it with a single compare-exchange
+            ////////////////////////////////////////////////////////////////////////////////////////////////////
+            struct alignas(64) Queue {
+                std::atomic<uint64_t> range;
+            };
+
+            uint32_t m_tileSize; ///< Width and height in pixels of the tiles
+            uint32_t m_width; ///< Width in pixels of the image
+            uint32_t m_height; ///< Height in pixels of the image
+            uint32_t m_tilesX; ///< Number of tile columns
+            uint32_t m_tilesY; ///< Number of tile rows
+            std::vector<uint32_t> m_tileOrder; ///< Row-major grid indices of all tiles, sorted in Morton order
+
+            std::unique_ptr<Queue[]> m_queues; ///< Per-thread tile queues
+            uint32_t m_queueCount = 0; ///< Number of queues in the `m_queues` array
+
+        };
+
+    } // namespace threads
+} // namespace yart
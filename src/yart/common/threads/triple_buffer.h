@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the TripleBuffer class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstdint>
+#include <atomic>
+
+
+namespace yart
+{
+    namespace threads
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Lock-free exchange of values between a single producer and a single consumer thread
+        /// @details Of the three buffers, one is owned by the producer for writing, one by the consumer for reading,
+        ///     and the remaining one holds the latest published value. Publishing and acquiring atomically swap
+        ///     a thread's own buffer with the middle one, so the producer always has a free buffer to write into,
+        ///     the consumer always gets the newest complete value, and neither of them ever waits for the other.
+        ///     Values published in between two acquires are dropped
+        /// @tparam T Buffer type
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        template<typename T>
+        class TripleBuffer {
+        public:
+            /// @brief Get the buffer owned by the producer
+            /// @note Should only be called from the producer thread
+            /// @return Buffer to write the next value into
+            T& GetWriteBuffer()
+            {
+                return m_buffers[m_writeIndex];
+            }
+
+            /// @brief Publish the write buffer as the latest value, and take over a free buffer for writing the next one
+            /// @note Should only be called from the producer thread. The contents of the new write buffer are left over from earlier values
+            void Publish()
+            {
+                const uint8_t middle = m_middle.exchange(m_writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+                m_writeIndex = middle & INDEX_MASK;
+            }
+
+            /// @brief Take over the latest published value for reading, if one has been published since the last call
+            /// @note Should only be called from the consumer thread
+            /// @return Whether a new value has been acquired. If not, the read buffer is left unchanged
+            bool Acquire()
+            {
+                // Only the consumer clears the fresh bit, so it cannot disappear between the check and the exchange
+                if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+                    return false;
+
+                const uint8_t middle = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+                m_readIndex = middle & INDEX_MASK;
+                return true;
+            }
+
+            /// @brief Get the buffer owned by the consumer
+            /// @note Should only be called from the consumer thread
+            /// @return Buffer holding the last acquired value
+            const T& GetReadBuffer() const
+            {
+                return m_buffers[m_readIndex];
+            }
+
+        private:
+            static constexpr uint8_t INDEX_MASK = 0x3; ///< Bits of the middle state holding the index of the middle buffer
+            static constexpr uint8_t FRESH_BIT = 0x4; ///< Bit of the middle state set when the middle buffer holds a value not acquired yet
+
+            T m_buffers[3]; ///< Exchanged buffers
+            uint8_t m_writeIndex = 0; ///< Index of the buffer owned by the producer
+            alignas(64) std::atomic<uint8_t> m_middle { 1 }; ///< Index of the middle buffer, along with the fresh bit
+            alignas(64) uint8_t m_readIndex = 2; ///< Index of the buffer owned by the consumer
+
+        };
+
+    } // namespace threads
+} // namespace yart
@@ -77,6 +77,33 @@ namespace yart
             return inverse_projection_matrix;
         }
 
+        /// @brief Create a modified camera projection matrix, which transforms camera space positions into raw (not normalized) screen coordinates
+        /// @details Inverse of the matrix created with CreateInverseProjectionMatrix(). Screen coordinates are retrieved by dividing 
+        ///     the x and y components of the transformed position by its w component, which holds the camera space depth
+        /// @param fov Horizontal camera field of view in radians
+        /// @param width Width of the screen in pixels
+        /// @param height Height of the screen in pixels
+        /// @param near_clip Near clipping plane distance
+        /// @tparam T A floating-point scalar type
+        /// @return The projection matrix
+        template<typename T>
+        GLM_FUNC_QUALIFIER glm::mat<4, 4, T, glm::defaultp> CreateProjectionMatrix(T fov, T width, T height, T near_clip)
+        {
+            T aspect_ratio = width / height;
+            T u = near_clip * glm::tan(fov / static_cast<T>(2.0));
+            T v = u / aspect_ratio;
+
+            glm::mat<4, 4, T, glm::defaultp> projection_matrix(0);
+            projection_matrix[0][0] = near_clip * width / (static_cast<T>(2.0) * u);  // | projection onto the near clipping plane + rescaling to pixels
+            projection_matrix[1][1] = near_clip * height / (static_cast<T>(2.0) * v); // |
+            projection_matrix[2][0] = width / static_cast<T>(2.0);  // | x,y translation from the camera view center to the lower-left corner
+            projection_matrix[2][1] = height / static_cast<T>(2.0); // |
+            projection_matrix[2][2] = static_cast<T>(1.0); // | camera space depth, used for the perspective division
+            projection_matrix[2][3] = static_cast<T>(1.0); // |
+
+            return projection_matrix;
+        }
+
         /// @brief Bilinearly interpolate between 4 values
         /// @param values A 2x2 kernel of color values to interpolate, starting at the upper-left corner and going column-first to the bottom-right corner
         /// @param tx Horizontal interpolation variable
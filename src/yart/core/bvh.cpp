@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of the BVH acceleration structure class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "bvh.h"
+
+
+#include <algorithm>
+#include <numeric>
+
+
+namespace yart
+{
+    void BVH::Build(const AABB* bounds, uint32_t count)
+    {
+        Clear();
+        if (count == 0)
+            return;
+
+        m_primitiveIndices.resize(count);
+        std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0);
+
+        std::vector<glm::vec3> centroids(count);
+        for (uint32_t i = 0; i < count; ++i)
+            centroids[i] = bounds[i].Centroid();
+
+        // A binary tree with N leaves has exactly 2N - 1 nodes, so node references stay valid during the build
+        m_nodes.reserve(2 * static_cast<size_t>(count) - 1);
+
+        Node& root = m_nodes.emplace_back();
+        root.leftFirst = 0;
+        root.count = count;
+        UpdateNodeBounds(0, bounds);
+
+        // Subdivide nodes top-down, using an explicit stack of (node index, depth) pairs
+        std::vector<std::pair<uint32_t, uint32_t>> stack;
+        stack.emplace_back(0, 0);
+
+        while (!stack.empty()) {
+            const auto [node_index, depth] = stack.back();
+            stack.pop_back();
+
+            Node& node = m_nodes[node_index];
+            if (node.count <= 1 || depth >= MAX_DEPTH)
+                continue;
+
+            int axis;
+            float split_position;
+            const float split_cost = FindBestSplitPlane(node, bounds, centroids.data(), &axis, &split_position);
+
+            // Keep the node as a leaf when splitting is not worth it, unless the leaf would grow too large
+            const AABB node_bounds = { node.boundsMin, node.boundsMax };
+            const float leaf_cost = static_cast<float>(node.count) * node_bounds.SurfaceArea();
+            if (split_cost >= leaf_cost - TRAVERSAL_COST * node_bounds.SurfaceArea() && node.count <= MAX_LEAF_SIZE)
+                continue;
+
+            if (split_cost == std::numeric_limits<float>::infinity())
+                continue; // All primitive centroids overlap, the node cannot be split
+
+            // Partition the primitive indices in-place around the split plane
+            uint32_t* first = m_primitiveIndices.data() + node.leftFirst;
+            uint32_t* last = first + node.count;
+            uint32_t* middle = std::partition(first, last, [&](uint32_t i) {
+                return centroids[i][axis] < split_position;
+            });
+
+            const uint32_t left_count = static_cast<uint32_t>(middle - first);
+            if (left_count == 0 || left_count == node.count)
+                continue;
+
+            const uint32_t left_index = static_cast<uint32_t>(m_nodes.size());
+            Node& left = m_nodes.emplace_back();
+            left.leftFirst = node.leftFirst;
+            left.count = left_count;
+
+            Node& right = m_nodes.emplace_back();
+            right.leftFirst = node.leftFirst + left_count;
+            right.count = node.count - left_count;
+
+            node.leftFirst = left_index;
+            node.count = 0;
+
+            UpdateNodeBounds(left_index, bounds);
+            UpdateNodeBounds(left_index + 1, bounds);
+
+            stack.emplace_back(left_index, depth + 1);
+            stack.emplace_back(left_index + 1, depth + 1);
+        }
+    }
+
+    void BVH::Clear()
+    {
+        m_nodes.clear();
+        m_primitiveIndices.clear();
+    }
+
+    AABB BVH::GetBounds() const
+    {
+        if (m_nodes.empty())
+            return AABB();
+
+        return { m_nodes[0].boundsMin, m_nodes[0].boundsMax };
+    }
+
+    void BVH::UpdateNodeBounds(uint32_t node_index, const AABB* bounds)
+    {
+        Node& node = m_nodes[node_index];
+
+        AABB node_bounds;
+        for (uint32_t i = 0; i < node.count; ++i)
+            node_bounds.Grow(bounds[m_primitiveIndices[node.leftFirst + i]]);
+
+        node.boundsMin = node_bounds.min;
+        node.boundsMax = node_bounds.max;
+    }
+
+    float BVH::FindBestSplitPlane(const Node& node, const AABB* bounds, const glm::vec3* centroids, int* axis, float* position) const
+    {
+        struct Bin {
+            AABB bounds;
+            uint32_t count = 0;
+        };
+
+        float best_cost = std::numeric_limits<float>::infinity();
+        for (int a = 0; a < 3; ++a) {
+            // Bin primitives by their centroids, rather than their bounds
+            float centroid_min = std::numeric_limits<float>::max();
+            float centroid_max = std::numeric_limits<float>::lowest();
+            for (uint32_t i = 0; i < node.count; ++i) {
+                const float c = centroids[m_primitiveIndices[node.leftFirst + i]][a];
+                centroid_min = glm::min(centroid_min, c);
+                centroid_max = glm::max(centroid_max, c);
+            }
+
+            if (centroid_min == centroid_max)
+                continue;
+
+            Bin bins[SAH_BINS_COUNT];
+            const float scale = static_cast<float>(SAH_BINS_COUNT) / (centroid_max - centroid_min);
+            for (uint32_t i = 0; i < node.count; ++i) {
+                const uint32_t primitive = m_primitiveIndices[node.leftFirst + i];
+                const uint32_t bin_index = glm::min(SAH_BINS_COUNT - 1, static_cast<uint32_t>((centroids[primitive][a] - centroid_min) * scale));
+
+                bins[bin_index].count++;
+                bins[bin_index].bounds.Grow(bounds[primitive]);
+            }
+
+            // Sweep the bins from both sides to gather area and primitive counts for each split candidate
+            float left_area[SAH_BINS_COUNT - 1], right_area[SAH_BINS_COUNT - 1];
+            uint32_t left_count[SAH_BINS_COUNT - 1], right_count[SAH_BINS_COUNT - 1];
+
+            AABB left_bounds, right_bounds;
+            uint32_t left_sum = 0, right_sum = 0;
+            for (uint32_t i = 0; i < SAH_BINS_COUNT - 1; ++i) {
+                left_sum += bins[i].count;
+                left_count[i] = left_sum;
+                left_bounds.Grow(bins[i].bounds);
+                left_area[i] = left_bounds.SurfaceArea();
+
+                right_sum += bins[SAH_BINS_COUNT - 1 - i].count;
+                right_count[SAH_BINS_COUNT - 2 - i] = right_sum;
+                right_bounds.Grow(bins[SAH_BINS_COUNT - 1 - i].bounds);
+                right_area[SAH_BINS_COUNT - 2 - i] = right_bounds.SurfaceArea();
+            }
+
+            const float bin_width = (centroid_max - centroid_min) / static_cast<float>(SAH_BINS_COUNT);
+            for (uint32_t i = 0; i < SAH_BINS_COUNT - 1; ++i) {
+                if (left_count[i] == 0 || right_count[i] == 0)
+                    continue;
+
+                const float cost = left_count[i] * left_area[i] + right_count[i] * right_area[i];
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    *axis = a;
+                    *position = centroid_min + bin_width * static_cast<float>(i + 1);
+                }
+            }
+        }
+
+        return best_cost;
+    }
+
+} // namespace yart
@@ -0,0 +1,345 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the BVH acceleration structure class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "yart/common/utils/yart_utils.h"
+#include "yart/core/ray.h"
+
+
+namespace yart
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Axis-aligned bounding box in three-dimensional space
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct AABB {
+    public:
+        /// @brief Expand the bounding box to contain a given point
+        /// @param point Point to be enclosed by the box
+        void Grow(const glm::vec3& point)
+        {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+
+        /// @brief Expand the bounding box to contain another bounding box
+        /// @param other Bounding box to be enclosed by the box
+        void Grow(const AABB& other)
+        {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+
+        /// @brief Get the surface area of the bounding box, used for evaluating the surface area heuristic
+        /// @return Surface area of the box, or zero for an empty box
+        float SurfaceArea() const
+        {
+            const glm::vec3 e = max - min;
+            if (e.x < 0.0f || e.y < 0.0f || e.z < 0.0f)
+                return 0.0f;
+
+            return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+        }
+
+        /// @brief Get the center point of the bounding box
+        /// @return Centroid of the box
+        glm::vec3 Centroid() const
+        {
+            return (min + max) * 0.5f;
+        }
+
+    public:
+        glm::vec3 min = glm::vec3(std::numeric_limits<float>::max()); ///< Minimum corner of the box
+        glm::vec3 max = glm::vec3(std::numeric_limits<float>::lowest()); ///< Maximum corner of the box
+
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Bounding volume hierarchy over an arbitrary set of bounded primitives
+    /// @details The tree is built top-down using the binned surface area heuristic (SAH) and stored as
+    ///     a flat array of nodes. Primitives themselves are not owned by the BVH, leaves only reference
+    ///     primitive indices passed in at build time
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    class BVH {
+    public:
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Single 32 byte node of the BVH
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct Node {
+        public:
+            /// @brief Whether the node is a leaf node, referencing primitives rather than child nodes
+            /// @return Whether the node is a leaf
+            bool IsLeaf() const
+            {
+                return count > 0;
+            }
+
+        public:
+            glm::vec3 boundsMin; ///< Minimum corner of the node bounding box
+            uint32_t leftFirst; ///< Index of the left child node (right child is `leftFirst + 1`), or index of the first primitive for leaf nodes
+            glm::vec3 boundsMax; ///< Maximum corner of the node bounding box
+            uint32_t count; ///< Number of primitives in the leaf node, or zero for interior nodes
+
+        };
+
+
+        /// @brief Build the hierarchy over a given set of primitive bounding boxes
+        /// @param bounds Array of primitive bounding boxes. The index of each box is used as its primitive index
+        /// @param count Size of the `bounds` array
+        void Build(const AABB* bounds, uint32_t count);
+
+        /// @brief Release all hierarchy nodes
+        void Clear();
+
+        /// @brief Get whether the hierarchy contains no primitives
+        /// @return Whether the hierarchy is empty
+        bool IsEmpty() const
+        {
+            return m_nodes.empty();
+        }
+
+        /// @brief Get the bounding box enclosing all primitives in the hierarchy
+        /// @return Root node bounding box
+        AABB GetBounds() const;
+
+        /// @brief Get the primitive indices in the order they are referenced by leaf nodes
+        /// @details Leaf nodes reference contiguous ranges of this array, so any per-primitive data stored 
+        ///     in the same order can be accessed directly by the ranges passed to BVH::TraverseLeaves()
+        /// @return Array of primitive indices, of size equal to the primitive count passed to BVH::Build()
+        const uint32_t* GetPrimitiveIndices() const
+        {
+            return m_primitiveIndices.data();
+        }
+
+        /// @brief Walk the hierarchy in front-to-back order and invoke a callback for each primitive of every leaf hit by the ray
+        /// @tparam F Callable type with a `bool(uint32_t primitive_index)` signature.
+        ///     Returning `true` from the callable terminates the traversal early
+        /// @param ray Traced ray
+        /// @param t_max Reference to the current closest hit distance. Nodes further away than this value are culled,
+        ///     so the callable is expected to shorten it on every registered hit
+        /// @param func Primitive intersection callback
+        /// @return Whether the traversal has been terminated early by the callback
+        template<typename F>
+        bool Traverse(const yart::Ray& ray, const float& t_max, F&& func) const;
+
+        /// @brief Walk the hierarchy in front-to-back order and invoke a callback for every leaf hit by the ray
+        /// @tparam F Callable type with a `bool(uint32_t first, uint32_t count)` signature, receiving the range of 
+        ///     the leaf in the BVH::GetPrimitiveIndices() array. Returning `true` from the callable terminates the traversal early
+        /// @param ray Traced ray
+        /// @param t_max Reference to the current closest hit distance. Nodes further away than this value are culled,
+        ///     so the callable is expected to shorten it on every registered hit
+        /// @param func Leaf intersection callback
+        /// @return Whether the traversal has been terminated early by the callback
+        template<typename F>
+        bool TraverseLeaves(const yart::Ray& ray, const float& t_max, F&& func) const;
+
+        /// @brief Walk the hierarchy with a packet of rays, sharing the traversal order between all rays in the packet
+        /// @details A node is visited whenever any active ray of the packet intersects its bounds. Rays are tracked with 
+        ///     32-bit masks, where the `i`-th bit corresponds to the `i`-th ray
+        /// @tparam F Callable type with a `void(uint32_t first, uint32_t count, uint32_t mask)` signature, receiving the range of 
+        ///     the leaf in the BVH::GetPrimitiveIndices() array and the mask of rays intersecting the leaf bounds
+        /// @param rays Array of rays, of size not larger than 32
+        /// @param mask Mask of active rays in the `rays` array
+        /// @param t_max Array of current closest hit distances for each ray. The callable is expected to shorten them on every registered hit
+        /// @param func Leaf intersection callback
+        template<typename F>
+        void TraversePacket(const yart::Ray* rays, uint32_t mask, const float* t_max, F&& func) const;
+
+    private:
+        /// @brief Recompute the bounding box of a node from the bounding boxes of its primitives
+        /// @param node_index Index of the node to update
+        /// @param bounds Array of primitive bounding boxes
+        void UpdateNodeBounds(uint32_t node_index, const AABB* bounds);
+
+        /// @brief Find the cheapest split plane of a node using the binned surface area heuristic
+        /// @param node Node to split
+        /// @param bounds Array of primitive bounding boxes
+        /// @param centroids Array of primitive bounding box centroids
+        /// @param axis Output parameter set to the split axis
+        /// @param position Output parameter set to the split plane position along `axis`
+        /// @return SAH cost of the split, or infinity if the node cannot be split
+        float FindBestSplitPlane(const Node& node, const AABB* bounds, const glm::vec3* centroids, int* axis, float* position) const;
+
+    private:
+        static constexpr uint32_t SAH_BINS_COUNT = 12; ///< Number of bins used to evaluate split candidates along each axis
+        static constexpr uint32_t MAX_LEAF_SIZE = 8; ///< Largest number of primitives stored in a single leaf
+        static constexpr uint32_t MAX_DEPTH = 63; ///< Maximum tree depth, bounding the size of the traversal stack
+        static constexpr float TRAVERSAL_COST = 1.0f; ///< SAH cost of traversing a node, relative to the cost of intersecting a single primitive
+
+        std::vector<Node> m_nodes; ///< Flattened tree nodes, with the root node at index `0`
+        std::vector<uint32_t> m_primitiveIndices; ///< Primitive indices referenced by leaf nodes
+
+    };
+
+
+    template<typename F>
+    bool BVH::Traverse(const yart::Ray& ray, const float& t_max, F&& func) const
+    {
+        return TraverseLeaves(ray, t_max, [&](uint32_t first, uint32_t count) {
+            for (uint32_t i = first; i < first + count; ++i) {
+                if (func(m_primitiveIndices[i]))
+                    return true;
+            }
+
+            return false;
+        });
+    }
+
+    template<typename F>
+    bool BVH::TraverseLeaves(const yart::Ray& ray, const float& t_max, F&& func) const
+    {
+        if (m_nodes.empty())
+            return false;
+
+        struct StackEntry {
+            uint32_t node;
+            float distance;
+        };
+
+        const glm::vec3 inv_direction = 1.0f / ray.direction;
+        StackEntry stack[MAX_DEPTH + 1];
+        size_t stack_size = 0;
+
+        float distance;
+        const Node* node = m_nodes.data();
+        if (!yart::Ray::IntersectAABB(ray, inv_direction, node->boundsMin, node->boundsMax, t_max, &distance))
+            return false;
+
+        while (true) {
+            if (node->IsLeaf()) {
+                if (func(node->leftFirst, node->count))
+                    return true;
+            } else {
+                uint32_t near_child = node->leftFirst;
+                uint32_t far_child = node->leftFirst + 1;
+
+                float near_distance, far_distance;
+                const Node* near_node = &m_nodes[near_child];
+                const Node* far_node = &m_nodes[far_child];
+                bool near_hit = yart::Ray::IntersectAABB(ray, inv_direction, near_node->boundsMin, near_node->boundsMax, t_max, &near_distance);
+                bool far_hit = yart::Ray::IntersectAABB(ray, inv_direction, far_node->boundsMin, far_node->boundsMax, t_max, &far_distance);
+
+                // Visit the closer child first
+                if (far_hit && (!near_hit || far_distance < near_distance)) {
+                    std::swap(near_child, far_child);
+                    std::swap(near_distance, far_distance);
+                    std::swap(near_hit, far_hit);
+                }
+
+                if (near_hit) {
+                    if (far_hit) {
+                        YART_ASSERT(stack_size <= MAX_DEPTH);
+                        stack[stack_size++] = { far_child, far_distance };
+                    }
+
+                    node = &m_nodes[near_child];
+                    continue;
+                }
+            }
+
+            // Pop the next node off the stack, skipping nodes made obsolete by a closer hit
+            node = nullptr;
+            while (stack_size > 0) {
+                const StackEntry& entry = stack[--stack_size];
+                if (entry.distance <= t_max) {
+                    node = &m_nodes[entry.node];
+                    break;
+                }
+            }
+
+            if (node == nullptr)
+                return false;
+        }
+    }
+
+    template<typename F>
+    void BVH::TraversePacket(const yart::Ray* rays, uint32_t mask, const float* t_max, F&& func) const
+    {
+        if (m_nodes.empty() || mask == 0)
+            return;
+
+        glm::vec3 inv_directions[32];
+        for (uint32_t i = 0; i < 32; ++i) {
+            if (mask & (1U << i))
+                inv_directions[i] = 1.0f / rays[i].direction;
+        }
+
+        // Intersect a node with all rays in a mask, returning the mask of hit rays and the closest entry distance
+        auto intersect_node = [&](const Node& node, uint32_t ray_mask, float* distance) {
+            uint32_t hit_mask = 0;
+            *distance = std::numeric_limits<float>::infinity();
+
+            for (uint32_t i = 0; i < 32; ++i) {
+                float t;
+                if ((ray_mask & (1U << i)) && yart::Ray::IntersectAABB(rays[i], inv_directions[i], node.boundsMin, node.boundsMax, t_max[i], &t)) {
+                    hit_mask |= 1U << i;
+                    *distance = glm::min(*distance, t);
+                }
+            }
+
+            return hit_mask;
+        };
+
+        struct StackEntry {
+            uint32_t node;
+            uint32_t mask;
+        };
+
+        StackEntry stack[MAX_DEPTH + 1];
+        size_t stack_size = 0;
+
+        float distance;
+        const Node* node = m_nodes.data();
+        mask = intersect_node(*node, mask, &distance);
+
+        while (true) {
+            if (mask != 0) {
+                if (node->IsLeaf()) {
+                    func(node->leftFirst, node->count, mask);
+                } else {
+                    uint32_t near_child = node->leftFirst;
+                    uint32_t far_child = node->leftFirst + 1;
+
+                    float near_distance, far_distance;
+                    uint32_t near_mask = intersect_node(m_nodes[near_child], mask, &near_distance);
+                    uint32_t far_mask = intersect_node(m_nodes[far_child], mask, &far_distance);
+
+                    // Visit the child closer to the packet first
+                    if (far_mask != 0 && (near_mask == 0 || far_distance < near_distance)) {
+                        std::swap(near_child, far_child);
+                        std::swap(near_mask, far_mask);
+                    }
+
+                    if (near_mask != 0) {
+                        if (far_mask != 0) {
+                            YART_ASSERT(stack_size <= MAX_DEPTH);
+                            stack[stack_size++] = { far_child, far_mask };
+                        }
+
+                        node = &m_nodes[near_child];
+                        mask = near_mask;
+                        continue;
+                    }
+                }
+            }
+
+            if (stack_size == 0)
+                return;
+
+            // Closer hits might have been registered since the node was pushed, so the ray mask is re-evaluated
+            const StackEntry& entry = stack[--stack_size];
+            node = &m_nodes[entry.node];
+            mask = intersect_node(*node, entry.mask, &distance);
+        }
+    }
+} // namespace yart
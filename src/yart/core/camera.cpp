@@ -32,6 +32,36 @@ namespace yart
         return m_rayDirectionsCache.data();
     }
 
+    void Camera::CopyView(const Camera& camera)
+    {
+        const bool view_changed = camera.m_lookDirection != m_lookDirection || camera.m_fieldOfView != m_fieldOfView 
+            || camera.m_nearClippingPlane != m_nearClippingPlane;
+
+        position = camera.position;
+        m_lookDirection = camera.m_lookDirection;
+        m_rotationYaw = camera.m_rotationYaw;
+        m_rotationPitch = camera.m_rotationPitch;
+        m_nearClippingPlane = camera.m_nearClippingPlane;
+        m_farClippingPlane = camera.m_farClippingPlane;
+        m_fieldOfView = camera.m_fieldOfView;
+
+        if (view_changed)
+            m_shouldRecalculateCache = true;
+    }
+
+    glm::mat4 Camera::GetViewProjectionMatrix(uint32_t width, uint32_t height) const
+    {
+        // World space to camera space, with the camera position moved into the origin
+        glm::mat4 view_matrix = yart::utils::CreateViewMatrix(m_lookDirection, UP_DIRECTION);
+        view_matrix[3] = view_matrix * glm::vec4(-position, 1.0f);
+
+        // Camera space to screen space
+        const float fov = m_fieldOfView * yart::utils::DEG_TO_RAD;
+        const glm::mat4 projection_matrix = yart::utils::CreateProjectionMatrix(fov, static_cast<float>(width), static_cast<float>(height), m_nearClippingPlane);
+
+        return projection_matrix * view_matrix;
+    }
+
     void Camera::GetRotation(float* pitch, float* yaw) const
     {
         if (pitch != nullptr)
@@ -78,14 +108,12 @@ namespace yart
         const glm::mat4 projection_matrix_inverse = yart::utils::CreateInverseProjectionMatrix(fov, w, h, m_nearClippingPlane);
         const glm::mat4 inverse_view_projection_matrix = view_matrix_inverse * projection_matrix_inverse;
 
-        // Precalculate ray directions for each pixel
-        size_t size = (width + 1) * (height + 1);
-        m_rayDirectionsCache.resize(size);
+        // Precalculate ray directions for each pixel, with an extra row for the vertical ray differentials of the last image row
+        m_rayDirectionsCache.resize(static_cast<size_t>(width) * (height + 1));
 
-        yart::threads::parallel_for<size_t>(0, size, [&](size_t i) {
-            const auto [y, x] = std::div(i, static_cast<int64_t>(width));
+        yart::threads::parallel_for_2d(width, height + 1, [&](uint32_t x, uint32_t y) {
             const glm::vec4 d = inverse_view_projection_matrix * glm::vec4{ x + 0.5f, y + 0.5f, 1.0f, 1.0f };
-            m_rayDirectionsCache[i] = glm::normalize(glm::vec3{ d.x, d.y, d.z });
+            m_rayDirectionsCache[static_cast<size_t>(y) * width + x] = glm::normalize(glm::vec3{ d.x, d.y, d.z });
         });
 
         m_shouldRecalculateCache = false;
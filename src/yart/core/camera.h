@@ -29,9 +29,25 @@ namespace yart
         /// @param height Height of the screen in pixels
         /// @param resized Optional output parameter. Given boolean variable is set to whether the
         ///     internal ray directions cache has been resized (width or height changed since last call)
-        /// @return A flattened array of size `width * height` of ray directions
+        /// @return A flattened, row-major array of ray directions of size `width * (height + 1)`. The extra row 
+        ///     holds the directions one pixel below the image, used for vertical ray differentials
         const glm::vec3* GetRayDirections(uint32_t width, uint32_t height, bool* resized = nullptr);
 
+        /// @brief Copy the viewing parameters of another camera, without its ray directions cache
+        /// @details The cache is only invalidated if any of the copied parameters it depends on have changed,
+        ///     so that cameras owned by different threads can be kept in sync cheaply
+        /// @param camera Camera instance to copy the view from
+        void CopyView(const Camera& camera);
+
+        /// @brief Get a matrix transforming world space positions into the camera's screen space
+        /// @details Matches the ray directions returned from Camera::GetRayDirections(), i.e. the ray through the center of 
+        ///     the pixel (x, y) passes through positions projected onto screen coordinates (x + 0.5, y + 0.5)
+        /// @param width Width of the screen in pixels
+        /// @param height Height of the screen in pixels
+        /// @return View-projection matrix. Screen coordinates are retrieved by dividing the x and y components of a transformed 
+        ///     position by its w component, which holds the camera space depth
+        glm::mat4 GetViewProjectionMatrix(uint32_t width, uint32_t height) const;
+
         /// @brief Get the current camera (pitch, yaw) rotation
         /// @param pitch Output parameter, populated with the pitch rotation amount in radians. Safe to pass in `nullptr`
         /// @param yaw Output parameter, populated with the yaw rotation amount in radians. Safe to pass in `nullptr`
@@ -133,8 +149,8 @@ namespace yart
         float m_fieldOfView = 60.0f; ///< Horizontal camera FOV in degrees
         
         std::vector<glm::vec3> m_rayDirectionsCache; ///< Cached ray directions for a given output size
-        uint32_t m_rayDirectionsCacheWidth;
-        uint32_t m_rayDirectionsCacheHeight;
+        uint32_t m_rayDirectionsCacheWidth = 0;
+        uint32_t m_rayDirectionsCacheHeight = 0;
         bool m_shouldRecalculateCache; ///< Whether the cache has been invalidated and should be rebuild 
 
     };
@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of the Framebuffer class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "framebuffer.h"
+
+
+#include <algorithm>
+#include <cstring>
+
+#include "yart/common/threads/parallel_for.h"
+
+
+namespace yart
+{
+    bool Framebuffer::Resize(uint32_t width, uint32_t height)
+    {
+        if (width == m_width && height == m_height)
+            return false;
+
+        m_width = width;
+        m_height = height;
+        m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+        m_tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+        m_data.resize(static_cast<size_t>(m_tilesX) * m_tilesY * TILE_SIZE * TILE_SIZE * CHANNELS);
+
+        return true;
+    }
+
+    void Framebuffer::Resolve(float buffer[]) const
+    {
+        // Each tile row is contiguous in both layouts, so rows are copied one tile-wide span at a time
+        yart::threads::parallel_for<uint32_t>(0, m_height, [&](uint32_t y) {
+            float* dst_row = buffer + static_cast<size_t>(y) * m_width * CHANNELS;
+
+            for (uint32_t x = 0; x < m_width; x += TILE_SIZE) {
+                const uint32_t span = std::min(TILE_SIZE, m_width - x);
+                std::memcpy(dst_row + static_cast<size_t>(x) * CHANNELS, GetPixel(x, y), span * CHANNELS * sizeof(float));
+            }
+        });
+    }
+} // namespace yart
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the Framebuffer class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace yart
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief RGBA float image stored in a tiled memory layout
+    /// @details The image is split into square tiles of Framebuffer::TILE_SIZE pixels, with the pixels
+    ///     of each tile stored contiguously in row-major order, so that rendering a single tile touches a
+    ///     compact block of memory. Tiles along the right and bottom image edges are padded to full size
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    class Framebuffer {
+    public:
+        /// @brief Resize the framebuffer. Contents are left undefined after a size change
+        /// @param width New width in pixels
+        /// @param height New height in pixels
+        /// @return Whether the size of the framebuffer has changed
+        bool Resize(uint32_t width, uint32_t height);
+
+        /// @brief Get the width of the framebuffer
+        /// @return Width in pixels
+        uint32_t GetWidth() const
+        {
+            return m_width;
+        }
+
+        /// @brief Get the height of the framebuffer
+        /// @return Height in pixels
+        uint32_t GetHeight() const
+        {
+            return m_height;
+        }
+
+        /// @brief Get the number of tile columns in the framebuffer
+        /// @return Tile column count
+        uint32_t GetTileCountX() const
+        {
+            return m_tilesX;
+        }
+
+        /// @brief Get the number of tile rows in the framebuffer
+        /// @return Tile row count
+        uint32_t GetTileCountY() const
+        {
+            return m_tilesY;
+        }
+
+        /// @brief Get the row-major index of the tile containing a given pixel
+        /// @param x Horizontal pixel coordinate
+        /// @param y Vertical pixel coordinate
+        /// @return Tile index
+        uint32_t GetTileIndex(uint32_t x, uint32_t y) const
+        {
+            return (y / TILE_SIZE) * m_tilesX + (x / TILE_SIZE);
+        }
+
+        /// @brief Get the number of pixels stored in the framebuffer, including the padding of edge tiles
+        /// @details Per-pixel data kept outside of the framebuffer can share its tiled layout, by indexing 
+        ///     arrays of this size with `GetPixelIndex(x, y) / CHANNELS`
+        /// @return Stored pixel count
+        size_t GetStoredPixelCount() const
+        {
+            return m_data.size() / CHANNELS;
+        }
+
+        /// @brief Get the index of a pixel's first channel in the tiled data array
+        /// @param x Horizontal pixel coordinate
+        /// @param y Vertical pixel coordinate
+        /// @return Data array index
+        size_t GetPixelIndex(uint32_t x, uint32_t y) const
+        {
+            const size_t tile = GetTileIndex(x, y);
+            const size_t local = (y % TILE_SIZE) * TILE_SIZE + (x % TILE_SIZE);
+
+            return (tile * TILE_SIZE * TILE_SIZE + local) * CHANNELS;
+        }
+
+        /// @brief Get a pointer to the channels of a pixel
+        /// @param x Horizontal pixel coordinate
+        /// @param y Vertical pixel coordinate
+        /// @return Pointer to Framebuffer::CHANNELS consecutive floats
+        float* GetPixel(uint32_t x, uint32_t y)
+        {
+            return m_data.data() + GetPixelIndex(x, y);
+        }
+
+        /// @brief Get a pointer to the channels of a pixel
+        /// @param x Horizontal pixel coordinate
+        /// @param y Vertical pixel coordinate
+        /// @return Pointer to Framebuffer::CHANNELS consecutive floats
+        const float* GetPixel(uint32_t x, uint32_t y) const
+        {
+            return m_data.data() + GetPixelIndex(x, y);
+        }
+
+        /// @brief Convert the framebuffer contents into a linear, row-major pixel array
+        /// @param buffer Output pixel array of size `width * height * CHANNELS`
+        void Resolve(float buffer[]) const;
+
+    public:
+        static constexpr uint32_t TILE_SIZE = 32; ///< Width and height in pixels of the framebuffer tiles
+        static constexpr uint32_t CHANNELS = 4; ///< Number of channels per pixel (RGBA)
+
+    private:
+        uint32_t m_width = 0; ///< Width of the framebuffer in pixels
+        uint32_t m_height = 0; ///< Height of the framebuffer in pixels
+        uint32_t m_tilesX = 0; ///< Number of tile columns
+        uint32_t m_tilesY = 0; ///< Number of tile rows
+        std::vector<float> m_data; ///< Tiled pixel data
+
+    };
+} // namespace yart
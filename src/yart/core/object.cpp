@@ -53,4 +53,50 @@ namespace yart
         return gen++;
     }
 
+    void Object::BuildMeshBVH()
+    {
+        YART_ASSERT(m_type == ObjectType::MESH);
+
+        std::vector<AABB> bounds(tris.size());
+        for (size_t i = 0; i < tris.size(); ++i) {
+            bounds[i].Grow(verts[tris[i].x]);
+            bounds[i].Grow(verts[tris[i].y]);
+            bounds[i].Grow(verts[tris[i].z]);
+        }
+
+        std::shared_ptr<yart::BVH> bvh = std::make_shared<yart::BVH>();
+        bvh->Build(bounds.data(), static_cast<uint32_t>(bounds.size()));
+        m_meshBVH = std::move(bvh);
+    }
+
+    void Object::BakeWorldTriangles()
+    {
+        YART_ASSERT(m_type == ObjectType::MESH);
+
+        const glm::mat4 transformation = GetTransformationMatrix();
+        const uint32_t* order = m_meshBVH->GetPrimitiveIndices();
+        const uint32_t count = static_cast<uint32_t>(tris.size());
+
+        std::shared_ptr<yart::TriangleSoA> triangles = std::make_shared<yart::TriangleSoA>();
+        triangles->Resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const glm::u32vec3& indices = tris[order[i]];
+            const glm::vec3 v0 = transformation * glm::vec4(verts[indices.x], 1.0f);
+            const glm::vec3 v1 = transformation * glm::vec4(verts[indices.y], 1.0f);
+            const glm::vec3 v2 = transformation * glm::vec4(verts[indices.z], 1.0f);
+
+            triangles->Set(i, v0, v1, v2);
+        }
+
+        m_worldTriangles = std::move(triangles);
+        m_worldTrianglesTransformation = transformation;
+    }
+
+    bool Object::ShouldBakeWorldTriangles()
+    {
+        YART_ASSERT(m_type == ObjectType::MESH);
+
+        return m_worldTriangles == nullptr || GetTransformationMatrix() != m_worldTrianglesTransformation;
+    }
+
 } // namespace yart
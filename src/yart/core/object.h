@@ -12,6 +12,9 @@
 
 #include <glm/glm.hpp>
 
+#include "yart/core/triangles.h"
+#include "yart/core/bvh.h"
+
 
 namespace yart
 {
@@ -97,6 +100,19 @@ namespace yart
         /// @return Unique ID
         static id_t GenerateID();
 
+        /// @brief Build the object-space bottom-level BVH over the object's mesh triangles
+        /// @details Should be called once, after the mesh data of the object has been set
+        void BuildMeshBVH();
+
+        /// @brief Recompute the cached world-space triangles of the mesh from the current transformation matrix
+        /// @details Triangles are stored in the leaf order of the mesh BVH, and should be re-baked whenever the transformation changes.
+        ///     A new triangle buffer is allocated each time, so that snapshots still referencing the previous one are left intact
+        void BakeWorldTriangles();
+
+        /// @brief Check whether the cached world-space triangles of the mesh are out of date
+        /// @return Whether the triangles have not been baked yet, or have been baked with a different transformation matrix
+        bool ShouldBakeWorldTriangles();
+
     public:
         glm::vec3 scale    = { 1.0f, 1.0f, 1.0f }; ///< Object scale for each axis
         glm::vec3 position = { 0.0f, 0.0f, 0.0f }; ///< Object origin position in world-space
@@ -135,6 +151,9 @@ namespace yart
         // Temporary mesh variables 
         std::vector<glm::vec3> verts;
         std::vector<glm::u32vec3> tris;
+        std::shared_ptr<const yart::BVH> m_meshBVH; ///< Object-space bottom-level BVH over the mesh triangles, shared with published scene snapshots. Valid only for ObjectType::MESH objects
+        std::shared_ptr<const yart::TriangleSoA> m_worldTriangles; ///< Cached world-space mesh triangles in the leaf order of `m_meshBVH`, shared with published scene snapshots. Valid only for ObjectType::MESH objects
+        glm::mat4 m_worldTrianglesTransformation { 0 }; ///< Transformation matrix `m_worldTriangles` have been baked with
         // std::vector<glm::vec2> UVs;
         // std::vector<glm::u32vec3> triangleUVs;
 
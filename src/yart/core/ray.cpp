@@ -6,7 +6,173 @@
 #include "ray.h"
 
 
+#include <limits>
+
+#include "yart/common/utils/yart_utils.h"
 #include "yart/common/utils/glm_utils.h"
+#include "yart/core/triangles.h"
+
+
+// Select the widest instruction set available at compile time for the vectorized intersection kernels
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define YART_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define YART_SIMD_WIDTH 4
+#else
+    #define YART_SIMD_WIDTH 1
+#endif
+
+
+#ifndef DOXYGEN_EXCLUDE // Exclude from documentation
+namespace
+{
+#if YART_SIMD_WIDTH == 8
+    /// @brief 8-wide AVX2 float vector operations
+    struct SimdOps {
+        using vec_t = __m256;
+        static constexpr uint32_t WIDTH = 8;
+
+        static vec_t Set1(float x) { return _mm256_set1_ps(x); }
+        static vec_t Load(const float* p) { return _mm256_loadu_ps(p); }
+        static void Store(float* p, vec_t a) { _mm256_storeu_ps(p, a); }
+        static vec_t LaneIndices() { return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f); }
+        static vec_t Add(vec_t a, vec_t b) { return _mm256_add_ps(a, b); }
+        static vec_t Sub(vec_t a, vec_t b) { return _mm256_sub_ps(a, b); }
+        static vec_t Mul(vec_t a, vec_t b) { return _mm256_mul_ps(a, b); }
+        static vec_t Div(vec_t a, vec_t b) { return _mm256_div_ps(a, b); }
+        static vec_t And(vec_t a, vec_t b) { return _mm256_and_ps(a, b); }
+        static vec_t Ge(vec_t a, vec_t b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static vec_t Le(vec_t a, vec_t b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        static vec_t Gt(vec_t a, vec_t b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static vec_t Lt(vec_t a, vec_t b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static vec_t Eq(vec_t a, vec_t b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        static vec_t Select(vec_t mask, vec_t a, vec_t b) { return _mm256_blendv_ps(b, a, mask); }
+        static int MoveMask(vec_t a) { return _mm256_movemask_ps(a); }
+
+        static float HorizontalMin(vec_t a)
+        {
+            __m128 m = _mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+            m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+            m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(m);
+        }
+    };
+#elif YART_SIMD_WIDTH == 4
+    /// @brief 4-wide SSE float vector operations
+    struct SimdOps {
+        using vec_t = __m128;
+        static constexpr uint32_t WIDTH = 4;
+
+        static vec_t Set1(float x) { return _mm_set1_ps(x); }
+        static vec_t Load(const float* p) { return _mm_loadu_ps(p); }
+        static void Store(float* p, vec_t a) { _mm_storeu_ps(p, a); }
+        static vec_t LaneIndices() { return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f); }
+        static vec_t Add(vec_t a, vec_t b) { return _mm_add_ps(a, b); }
+        static vec_t Sub(vec_t a, vec_t b) { return _mm_sub_ps(a, b); }
+        static vec_t Mul(vec_t a, vec_t b) { return _mm_mul_ps(a, b); }
+        static vec_t Div(vec_t a, vec_t b) { return _mm_div_ps(a, b); }
+        static vec_t And(vec_t a, vec_t b) { return _mm_and_ps(a, b); }
+        static vec_t Ge(vec_t a, vec_t b) { return _mm_cmpge_ps(a, b); }
+        static vec_t Le(vec_t a, vec_t b) { return _mm_cmple_ps(a, b); }
+        static vec_t Gt(vec_t a, vec_t b) { return _mm_cmpgt_ps(a, b); }
+        static vec_t Lt(vec_t a, vec_t b) { return _mm_cmplt_ps(a, b); }
+        static vec_t Eq(vec_t a, vec_t b) { return _mm_cmpeq_ps(a, b); }
+        static vec_t Select(vec_t mask, vec_t a, vec_t b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+        static int MoveMask(vec_t a) { return _mm_movemask_ps(a); }
+
+        static float HorizontalMin(vec_t a)
+        {
+            __m128 m = _mm_min_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+            m = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+            return _mm_cvtss_f32(m);
+        }
+    };
+#endif
+
+#if YART_SIMD_WIDTH > 1
+    /// @brief Vectorized Möller-Trumbore intersection of a single ray against `SimdOps::WIDTH` triangles at a time
+    bool IntersectTrianglesSimd(const yart::Ray& ray, const yart::TriangleSoA& triangles, uint32_t first, uint32_t count,
+        float t_max, float* t, float* u, float* v, uint32_t* index
+    )
+    {
+        using S = SimdOps;
+        using vec_t = S::vec_t;
+
+        const vec_t ox = S::Set1(ray.origin.x), oy = S::Set1(ray.origin.y), oz = S::Set1(ray.origin.z);
+        const vec_t dx = S::Set1(ray.direction.x), dy = S::Set1(ray.direction.y), dz = S::Set1(ray.direction.z);
+        const vec_t zero = S::Set1(0.0f);
+        const vec_t one = S::Set1(1.0f);
+        const vec_t epsilon = S::Set1(yart::utils::EPSILON);
+        const vec_t infinity = S::Set1(std::numeric_limits<float>::infinity());
+        const vec_t lanes = S::LaneIndices();
+
+        bool hit = false;
+        float closest = t_max;
+
+        for (uint32_t i = first; i < first + count; i += S::WIDTH) {
+            const vec_t v0x = S::Load(&triangles.v0[0][i]), v0y = S::Load(&triangles.v0[1][i]), v0z = S::Load(&triangles.v0[2][i]);
+            const vec_t e1x = S::Load(&triangles.edge1[0][i]), e1y = S::Load(&triangles.edge1[1][i]), e1z = S::Load(&triangles.edge1[2][i]);
+            const vec_t e2x = S::Load(&triangles.edge2[0][i]), e2y = S::Load(&triangles.edge2[1][i]), e2z = S::Load(&triangles.edge2[2][i]);
+
+            // P = cross(direction, E02)
+            const vec_t px = S::Sub(S::Mul(dy, e2z), S::Mul(dz, e2y));
+            const vec_t py = S::Sub(S::Mul(dz, e2x), S::Mul(dx, e2z));
+            const vec_t pz = S::Sub(S::Mul(dx, e2y), S::Mul(dy, e2x));
+
+            const vec_t det = S::Add(S::Add(S::Mul(e1x, px), S::Mul(e1y, py)), S::Mul(e1z, pz));
+            const vec_t inv_det = S::Div(one, det);
+
+            // T = origin - v0
+            const vec_t tx = S::Sub(ox, v0x), ty = S::Sub(oy, v0y), tz = S::Sub(oz, v0z);
+            const vec_t uu = S::Mul(S::Add(S::Add(S::Mul(tx, px), S::Mul(ty, py)), S::Mul(tz, pz)), inv_det);
+
+            // Q = cross(T, E01)
+            const vec_t qx = S::Sub(S::Mul(ty, e1z), S::Mul(tz, e1y));
+            const vec_t qy = S::Sub(S::Mul(tz, e1x), S::Mul(tx, e1z));
+            const vec_t qz = S::Sub(S::Mul(tx, e1y), S::Mul(ty, e1x));
+
+            const vec_t vv = S::Mul(S::Add(S::Add(S::Mul(dx, qx), S::Mul(dy, qy)), S::Mul(dz, qz)), inv_det);
+            const vec_t tt = S::Mul(S::Add(S::Add(S::Mul(e2x, qx), S::Mul(e2y, qy)), S::Mul(e2z, qz)), inv_det);
+
+            // Same acceptance rules as the scalar kernel, including back face culling
+            vec_t mask = S::Ge(det, epsilon);
+            mask = S::And(mask, S::And(S::Ge(uu, zero), S::Le(uu, one)));
+            mask = S::And(mask, S::And(S::Ge(vv, zero), S::Le(S::Add(uu, vv), one)));
+            mask = S::And(mask, S::And(S::Gt(tt, zero), S::Lt(tt, S::Set1(closest))));
+            mask = S::And(mask, S::Lt(lanes, S::Set1(static_cast<float>(first + count - i))));
+
+            if (S::MoveMask(mask) == 0)
+                continue;
+
+            const vec_t masked_t = S::Select(mask, tt, infinity);
+            const float block_closest = S::HorizontalMin(masked_t);
+            const int lane_bits = S::MoveMask(S::Eq(masked_t, S::Set1(block_closest)));
+
+            uint32_t lane = 0;
+            while ((lane_bits & (1 << lane)) == 0)
+                ++lane;
+
+            float us[S::WIDTH], vs[S::WIDTH];
+            S::Store(us, uu);
+            S::Store(vs, vv);
+
+            hit = true;
+            closest = block_closest;
+            *u = us[lane];
+            *v = vs[lane];
+            *index = i + lane;
+        }
+
+        if (hit)
+            *t = closest;
+
+        return hit;
+    }
+#endif
+} // namespace
+#endif // ifndef DOXYGEN_EXCLUDE
 
 
 namespace yart
@@ -14,11 +180,15 @@ namespace yart
     bool Ray::IntersectTriangle(const Ray& ray, 
         const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float* t, float* u, float* v
     )
+    {
+        return IntersectTriangleEdges(ray, v0, v1 - v0, v2 - v0, t, u, v);
+    }
+
+    bool Ray::IntersectTriangleEdges(const Ray& ray, 
+        const glm::vec3& v0, const glm::vec3& E01, const glm::vec3& E02, float* t, float* u, float* v
+    )
     {
         // https://www.scratchapixel.com/lessons/3d-basic-rendering/ray-tracing-rendering-a-triangle/moller-trumbore-ray-triangle-intersection.html
-        
-        glm::vec3 E01 = v1 - v0;
-        glm::vec3 E02 = v2 - v0;
 
         glm::vec3 P = glm::cross(ray.direction, E02);
         float det = glm::dot(E01, P);
@@ -43,4 +213,34 @@ namespace yart
 
         return true;
     }
+
+    bool Ray::IntersectTriangles(const Ray& ray, const TriangleSoA& triangles, uint32_t first, uint32_t count, 
+        float t_max, float* t, float* u, float* v, uint32_t* index
+    )
+    {
+        YART_ASSERT(first + count <= triangles.Size());
+
+#if YART_SIMD_WIDTH > 1
+        return IntersectTrianglesSimd(ray, triangles, first, count, t_max, t, u, v, index);
+#else
+        bool hit = false;
+        float closest = t_max;
+
+        for (uint32_t i = first; i < first + count; ++i) {
+            float tt, uu, vv;
+            if (IntersectTriangleEdges(ray, triangles.GetVertex0(i), triangles.GetEdge1(i), triangles.GetEdge2(i), &tt, &uu, &vv) && tt > 0.0f && tt < closest) {
+                hit = true;
+                closest = tt;
+                *u = uu;
+                *v = vv;
+                *index = i;
+            }
+        }
+
+        if (hit)
+            *t = closest;
+
+        return hit;
+#endif
+    }
 } // namespace yart
@@ -6,11 +6,16 @@
 #pragma once
 
 
+#include <cstdint>
+
 #include <glm/glm.hpp>
 
 
 namespace yart
 {
+    struct TriangleSoA; // yart::TriangleSoA struct forward declaration
+
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////
     /// @brief Structure defining a ray in three-dimensional space
     ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,5 +47,90 @@ namespace yart
             const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, float* t, float* u, float* v
         );
 
+        /// @brief Ray-triangle intersection check for triangles with precomputed edge vectors, implemented using the Möller-Trumbore algorithm
+        /// @param ray Traced ray
+        /// @param v0 First vertex of the triangle in world space
+        /// @param e1 First edge vector of the triangle (`v1 - v0`)
+        /// @param e2 Second edge vector of the triangle (`v2 - v0`)
+        /// @param t Output parameter set on valid intersection with distance from the ray's origin to the intersection point value
+        /// @param u Output parameter set on valid intersection with barycentric u parameter value
+        /// @param v Output parameter set on valid intersection with barycentric v parameter value
+        /// @return Whether the ray intersected with the triangle and the output parameters were populated
+        static bool IntersectTriangleEdges(const Ray& ray, 
+            const glm::vec3& v0, const glm::vec3& e1, const glm::vec3& e2, float* t, float* u, float* v
+        );
+
+        /// @brief Ray-triangle intersection check against a range of triangles in SoA layout, returning the closest hit
+        /// @details Vectorized counterpart of Ray::IntersectTriangleEdges(), testing 8 (AVX2) or 4 (SSE) triangles at a time, 
+        ///     depending on the instruction set enabled at compile time
+        /// @param ray Traced ray
+        /// @param triangles Triangle storage
+        /// @param first Index of the first tested triangle
+        /// @param count Number of tested triangles
+        /// @param t_max Distance from the ray's origin, beyond which hits are ignored
+        /// @param t Output parameter set on valid intersection with distance from the ray's origin to the closest intersection point
+        /// @param u Output parameter set on valid intersection with barycentric u parameter value of the closest intersection
+        /// @param v Output parameter set on valid intersection with barycentric v parameter value of the closest intersection
+        /// @param index Output parameter set on valid intersection with the storage index of the closest hit triangle
+        /// @return Whether the ray intersected with any triangle in the (0, t_max) range and the output parameters were populated
+        static bool IntersectTriangles(const Ray& ray, const TriangleSoA& triangles, uint32_t first, uint32_t count, 
+            float t_max, float* t, float* u, float* v, uint32_t* index
+        );
+
+        /// @brief Ray-AABB intersection check, implemented using the slab method
+        /// @param ray Traced ray
+        /// @param inv_direction Component-wise inverse of the ray's direction vector
+        /// @param min Minimum corner of the bounding box
+        /// @param max Maximum corner of the bounding box
+        /// @param t_max Largest distance along the ray for an intersection to be considered valid
+        /// @param t Output parameter set to the distance from the ray's origin to the entry point of the box
+        /// @return Whether the ray intersected with the box within the [0, t_max] range
+        static bool IntersectAABB(const Ray& ray, const glm::vec3& inv_direction,
+            const glm::vec3& min, const glm::vec3& max, float t_max, float* t
+        )
+        {
+            const glm::vec3 t0 = (min - ray.origin) * inv_direction;
+            const glm::vec3 t1 = (max - ray.origin) * inv_direction;
+            const glm::vec3 t_near = glm::min(t0, t1);
+            const glm::vec3 t_far = glm::max(t0, t1);
+
+            const float t_enter = glm::max(glm::max(t_near.x, t_near.y), glm::max(t_near.z, 0.0f));
+            const float t_exit = glm::min(glm::min(t_far.x, t_far.y), glm::min(t_far.z, t_max));
+
+            *t = t_enter;
+            return t_enter <= t_exit;
+        }
+
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Fixed-size bundle of rays, traced through the scene together
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct RayPacket {
+    public:
+        /// @brief Check whether all rays in the packet point into the same octant
+        /// @details Packets with coherent directions visit mostly the same BVH nodes, making shared traversal worthwhile
+        /// @return Whether the packet is coherent
+        bool IsCoherent() const
+        {
+            // Encode the direction signs of each ray as a 3-bit octant index
+            auto octant = [](const glm::vec3& d) {
+                return (d.x < 0.0f ? 1 : 0) | (d.y < 0.0f ? 2 : 0) | (d.z < 0.0f ? 4 : 0);
+            };
+
+            for (uint32_t i = 1; i < count; ++i) {
+                if (octant(rays[i].direction) != octant(rays[0].direction))
+                    return false;
+            }
+
+            return true;
+        }
+
+    public:
+        static constexpr uint32_t SIZE = 16; ///< Maximum number of rays in a packet. Rays are tracked in 32-bit masks, so it should not exceed 32
+
+        yart::Ray rays[SIZE]; ///< Rays of the packet
+        uint32_t count = 0; ///< Number of valid rays in the `rays` array
+
     };
 } // namespace yart
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of the RenderHistory class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "render_history.h"
+
+
+#include <algorithm>
+#include <cstring>
+
+#include "yart/common/threads/parallel_for.h"
+
+
+namespace yart
+{
+    /// @brief Get the depth of a packed reprojection target
+    /// @param packed Depth and source pixel index, packed into a single integer
+    /// @return Camera space depth of the reprojected hit
+    static float UnpackDepth(uint64_t packed)
+    {
+        const uint32_t depth_bits = static_cast<uint32_t>(packed >> 32);
+        float value;
+        std::memcpy(&value, &depth_bits, sizeof(float));
+        return value;
+    }
+
+
+    void RenderHistory::Resize(uint32_t width, uint32_t height)
+    {
+        const size_t pixel_count = static_cast<size_t>(width) * height;
+        m_width = width;
+        m_height = height;
+
+        m_samples.resize(pixel_count);
+        m_previousSamples.resize(pixel_count);
+        m_radiance.resize(pixel_count);
+        m_previousRadiance.resize(pixel_count);
+        m_previousColors.resize(pixel_count * yart::Framebuffer::CHANNELS);
+        m_reprojectionTargets = std::make_unique<std::atomic<uint64_t>[]>(pixel_count);
+
+        m_valid = false;
+    }
+
+    void RenderHistory::SetView(const yart::Camera& camera, uint32_t shading, const yart::World& world)
+    {
+        m_valid = true;
+        m_cameraPosition = camera.position;
+        m_cameraDirection = camera.GetLookDirection();
+        m_cameraFOV = camera.GetFOV();
+        m_nearClippingPlane = camera.GetNearClippingPlane();
+        m_farClippingPlane = camera.GetFarClippingPlane();
+        m_shading = shading;
+
+        for (size_t i = 0; i < yart::World::LIGHT_COUNT; ++i)
+            m_lightPositions[i] = world.lights[i].position;
+    }
+
+    bool RenderHistory::IsView(const yart::Camera& camera) const
+    {
+        // Changes of the field of view or the clipping planes move the recorded hits without moving the camera.
+        // Image size changes are not checked, as resizing invalidates the record
+        return m_valid && camera.position == m_cameraPosition && camera.GetLookDirection() == m_cameraDirection
+            && camera.GetFOV() == m_cameraFOV && camera.GetNearClippingPlane() == m_nearClippingPlane
+            && camera.GetFarClippingPlane() == m_farClippingPlane;
+    }
+
+    bool RenderHistory::IsMovedView(const yart::Camera& camera) const
+    {
+        return m_valid && (camera.position != m_cameraPosition || camera.GetLookDirection() != m_cameraDirection);
+    }
+
+    bool RenderHistory::IsShading(uint32_t shading, const yart::World& world) const
+    {
+        if (m_shading != shading)
+            return false;
+
+        // Light positions affect the shadows, unlike the rest of the lighting parameters
+        for (size_t i = 0; i < yart::World::LIGHT_COUNT; ++i) {
+            if (m_lightPositions[i] != world.lights[i].position)
+                return false;
+        }
+
+        return true;
+    }
+
+    void RenderHistory::BeginReprojection(const yart::Framebuffer& framebuffer, const yart::Camera& camera)
+    {
+        const size_t pixel_count = static_cast<size_t>(m_width) * m_height;
+        std::atomic<uint64_t>* targets = m_reprojectionTargets.get();
+
+        // The record of the previous view is moved aside, as the current one is recorded while reprojecting
+        m_valid = false;
+        std::swap(m_samples, m_previousSamples);
+        std::swap(m_radiance, m_previousRadiance);
+        framebuffer.Resolve(m_previousColors.data());
+
+        yart::threads::parallel_for(size_t(0), pixel_count, [&](size_t i) {
+            targets[i].store(REPROJECTION_EMPTY, std::memory_order_relaxed);
+        });
+
+        // Scatter the previous primary hits into the new view, keeping the closest hit for each pixel
+        const glm::mat4 view_projection = camera.GetViewProjectionMatrix(m_width, m_height);
+        const float near = camera.GetNearClippingPlane();
+
+        yart::threads::parallel_for(size_t(0), pixel_count, [&](size_t i) {
+            const glm::vec4& hit = m_previousSamples[i].hit;
+            if (hit.w == 0.0f)
+                return;
+
+            const glm::vec4 p = view_projection * glm::vec4(glm::vec3(hit), 1.0f);
+            if (p.w < near)
+                return;
+
+            const float screen_x = p.x / p.w;
+            const float screen_y = p.y / p.w;
+            if (!(screen_x >= 0.0f && screen_y >= 0.0f && screen_x < static_cast<float>(m_width) && screen_y < static_cast<float>(m_height)))
+                return;
+
+            // Bit patterns of positive floats are ordered the same as their values, so depths can be compared as integers
+            uint32_t depth_bits;
+            std::memcpy(&depth_bits, &p.w, sizeof(float));
+
+            const uint64_t packed = static_cast<uint64_t>(depth_bits) << 32 | static_cast<uint64_t>(i);
+            std::atomic<uint64_t>& target = targets[static_cast<size_t>(screen_y) * m_width + static_cast<size_t>(screen_x)];
+
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (packed < current && !target.compare_exchange_weak(current, packed, std::memory_order_relaxed)) { }
+        });
+    }
+
+    bool RenderHistory::FindReprojectionSource(uint32_t x, uint32_t y, size_t* source) const
+    {
+        const std::atomic<uint64_t>* targets = m_reprojectionTargets.get();
+        const uint64_t target = targets[static_cast<size_t>(y) * m_width + x].load(std::memory_order_relaxed);
+        if (target == REPROJECTION_EMPTY)
+            return false;
+
+        const float occluder_depth = UnpackDepth(target) * (1.0f - REPROJECTION_DEPTH_TOLERANCE);
+        for (uint32_t ny = (y > 0 ? y - 1 : y); ny <= std::min(y + 1, m_height - 1); ++ny) {
+            for (uint32_t nx = (x > 0 ? x - 1 : x); nx <= std::min(x + 1, m_width - 1); ++nx) {
+                const uint64_t neighbour = targets[static_cast<size_t>(ny) * m_width + nx].load(std::memory_order_relaxed);
+                if (neighbour != REPROJECTION_EMPTY && UnpackDepth(neighbour) < occluder_depth)
+                    return false;
+            }
+        }
+
+        *source = static_cast<size_t>(target & 0xFFFFFFFF);
+        return true;
+    }
+
+    glm::vec3 RenderHistory::Reproject(size_t pixel, size_t source)
+    {
+        m_samples[pixel] = m_previousSamples[source];
+        m_radiance[pixel] = m_previousRadiance[source];
+
+        const float* color = &m_previousColors[source * yart::Framebuffer::CHANNELS];
+        return { color[0], color[1], color[2] };
+    }
+} // namespace yart
@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the RenderHistory class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <memory>
+#include <atomic>
+
+#include <glm/glm.hpp>
+
+#include "yart/core/framebuffer.h"
+#include "yart/core/camera.h"
+#include "yart/core/world.h"
+
+
+namespace yart
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Radiance of a traced ray, decomposed into terms scaled linearly by the world's lighting parameters
+    /// @details The traced color equals the constant term, plus the ambient color scaled by Renderer::AMBIENT_STRENGTH and the ambient weight,
+    ///     plus the diffuse and specular terms of each light scaled by its intensity, plus the sky color sampled at the sky direction
+    ///     scaled by the sky weight. Only a single sky sample is needed, as at most one ray of a traced path can miss the scene
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct RadianceSample {
+    public:
+        /// @brief Linearly interpolate towards the radiance of another ray, e.g. a reflection
+        /// @param other Radiance of the other ray
+        /// @param t Interpolation factor, where 1 results in the other ray's radiance
+        void Blend(const RadianceSample& other, float t)
+        {
+            constant += (other.constant - constant) * t;
+            ambientWeight += (other.ambientWeight - ambientWeight) * t;
+            for (size_t i = 0; i < yart::World::LIGHT_COUNT; ++i) {
+                diffuse[i] += (other.diffuse[i] - diffuse[i]) * t;
+                specular[i] += (other.specular[i] - specular[i]) * t;
+            }
+
+            if (other.skyWeight > 0.0f)
+                skyDirection = other.skyDirection;
+
+            skyWeight += (other.skyWeight - skyWeight) * t;
+        }
+
+        /// @brief Linearly interpolate towards a color independent of the lighting, e.g. an overlay
+        /// @param color Constant color
+        /// @param t Interpolation factor, where 1 results in the constant color
+        void Blend(const glm::vec3& color, float t)
+        {
+            constant += (color - constant) * t;
+            ambientWeight *= 1.0f - t;
+            for (size_t i = 0; i < yart::World::LIGHT_COUNT; ++i) {
+                diffuse[i] *= 1.0f - t;
+                specular[i] *= 1.0f - t;
+            }
+
+            skyWeight *= 1.0f - t;
+        }
+
+    public:
+        glm::vec3 constant; ///< Radiance independent of the lighting, e.g. overlays and debug shading
+        float ambientWeight; ///< Weight of the ambient color
+        glm::vec3 diffuse[yart::World::LIGHT_COUNT]; ///< Diffuse radiance of each light at unit intensity
+        float specular[yart::World::LIGHT_COUNT]; ///< Specular radiance of each light at unit intensity, equal in all color channels
+        glm::vec3 skyDirection; ///< Direction of the sky sample
+        float skyWeight; ///< Weight of the sky sample
+
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Rays of a single pixel recorded in the history, traced through its center in the first frame of a view
+    /// @details Holds everything needed for shading the primary hit, so that the history doubles as a G-buffer
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct HistorySample {
+        glm::vec4 hit; ///< World-space primary hit position in xyz, with w set to 1 on hit and 0 on miss
+        glm::vec3 normal; ///< Surface normal at the primary hit
+        glm::vec2 barycentrics; ///< Barycentric coordinates of the primary hit triangle, or zero for SDF hits
+        uint32_t object; ///< Index of the primary hit object in the scene snapshot, or RenderHistory::NO_OBJECT on miss
+        uint32_t reflectedObject; ///< Index of the object hit by the first reflection bounce in the scene snapshot, or RenderHistory::NO_OBJECT
+        bool reflected; ///< Whether a reflection ray has been traced from the primary hit
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Per-pixel record of the rays traced in the first frame of a view, reused by the first frames of the following views
+    /// @details Holds the history sample and the radiance decomposition of each pixel, along with the view and the shading
+    ///     they have been recorded with. Reprojecting into a new view moves the record of the previous view aside
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    class RenderHistory {
+    public:
+        /// @brief Resize the record for a given image size, invalidating it
+        /// @param width Width in pixels of the image
+        /// @param height Height in pixels of the image
+        void Resize(uint32_t width, uint32_t height);
+
+        /// @brief Mark the record as complete for a given view
+        /// @param camera YART camera instance of the view, whose primary hits have been recorded.
+        ///     Its position, look direction, field of view and clipping planes make up the history view
+        /// @param shading Bit mask of the render settings affecting the shading of surfaces, which the view has been rendered with
+        /// @param world World the view has been rendered with. Only its light positions are kept, as they affect the shadows
+        void SetView(const yart::Camera& camera, uint32_t shading, const yart::World& world);
+
+        /// @brief Mark the record as incomplete, e.g. while it is being overwritten
+        void Invalidate()
+        {
+            m_valid = false;
+        }
+
+        /// @brief Check whether the record is complete
+        /// @return Whether the record holds all pixels of the history view
+        bool IsValid() const
+        {
+            return m_valid;
+        }
+
+        /// @brief Check whether the record is complete for the view of a given camera
+        /// @param camera YART camera instance of the frame
+        /// @return Whether the record is complete, and the camera position, look direction, field of view and clipping planes
+        ///     are unchanged since it has been recorded
+        bool IsView(const yart::Camera& camera) const;
+
+        /// @brief Check whether a given camera has moved or turned since the record has been completed
+        /// @param camera YART camera instance of the frame
+        /// @return Whether the record is complete, and the camera position or look direction has changed
+        bool IsMovedView(const yart::Camera& camera) const;
+
+        /// @brief Check whether the record has been shaded with given render settings and light positions
+        /// @param shading Bit mask of the render settings affecting the shading of surfaces
+        /// @param world World of the frame
+        /// @return Whether the recorded colors and radiance decompositions are up to date, apart from the lighting parameters
+        bool IsShading(uint32_t shading, const yart::World& world) const;
+
+        /// @brief Get the recorded history sample of a pixel
+        /// @param pixel Linear index of the pixel
+        /// @return History sample
+        yart::HistorySample& GetSample(size_t pixel)
+        {
+            return m_samples[pixel];
+        }
+
+        /// @brief Get the recorded radiance decomposition of a pixel
+        /// @param pixel Linear index of the pixel
+        /// @return Radiance decomposition
+        const yart::RadianceSample& GetRadiance(size_t pixel) const
+        {
+            return m_radiance[pixel];
+        }
+
+        /// @brief Record the rays of a pixel
+        /// @param pixel Linear index of the pixel
+        /// @param sample History sample of the pixel
+        /// @param radiance Radiance decomposition of the pixel
+        void Record(size_t pixel, const yart::HistorySample& sample, const yart::RadianceSample& radiance)
+        {
+            m_samples[pixel] = sample;
+            m_radiance[pixel] = radiance;
+        }
+
+        /// @brief Record the radiance decomposition of a pixel, whose history sample is kept
+        /// @param pixel Linear index of the pixel
+        /// @param radiance Radiance decomposition of the pixel
+        void Record(size_t pixel, const yart::RadianceSample& radiance)
+        {
+            m_radiance[pixel] = radiance;
+        }
+
+        /// @brief Move the record of the previous view aside, and scatter its primary hits into a new view
+        /// @details Each pixel of the new view keeps the closest hit scattered onto it. The record is invalid until the new view is set
+        /// @param framebuffer Framebuffer holding the image of the previous view
+        /// @param camera YART camera instance of the new view
+        void BeginReprojection(const yart::Framebuffer& framebuffer, const yart::Camera& camera);
+
+        /// @brief Find the pixel of the previous view, whose hit has been reprojected onto a pixel of the new view
+        /// @details Background hits can slip through the gaps in between the reprojected hits of a closer surface,
+        ///     so hits much deeper than those of any of the neighbouring pixels might not actually be visible
+        /// @param x Horizontal pixel coordinate
+        /// @param y Vertical pixel coordinate
+        /// @param source Output parameter set with the linear index of the pixel in the previous view
+        /// @return Whether a visible hit has been reprojected onto the pixel
+        bool FindReprojectionSource(uint32_t x, uint32_t y, size_t* source) const;
+
+        /// @brief Copy the record of a pixel of the previous view into a pixel of the new view
+        /// @param pixel Linear index of the pixel in the new view
+        /// @param source Linear index of the pixel in the previous view
+        /// @return Color of the source pixel in the image of the previous view
+        glm::vec3 Reproject(size_t pixel, size_t source);
+
+    public:
+        static constexpr uint32_t NO_OBJECT = std::numeric_limits<uint32_t>::max(); ///< Object index recorded for rays which have missed the scene
+
+    private:
+        static constexpr uint64_t REPROJECTION_EMPTY = ~0ULL; ///< Packed reprojection target of pixels, onto which no hit has been reprojected
+        static constexpr float REPROJECTION_DEPTH_TOLERANCE = 0.1f; ///< Relative depth difference to a neighbouring pixel, above which a reprojected hit is considered occluded
+
+        uint32_t m_width = 0; ///< Width in pixels of the recorded image
+        uint32_t m_height = 0; ///< Height in pixels of the recorded image
+        std::vector<yart::HistorySample> m_samples; ///< Per-pixel rays traced through the pixel centers of the history view
+        std::vector<yart::HistorySample> m_previousSamples; ///< History samples of the previous view, read while reprojecting
+        std::vector<yart::RadianceSample> m_radiance; ///< Per-pixel radiance decomposition of the recorded rays
+        std::vector<yart::RadianceSample> m_previousRadiance; ///< Radiance decomposition of the previous view, read while reprojecting
+        std::vector<float> m_previousColors; ///< Linear RGBA image of the previous view, read while reprojecting
+        std::unique_ptr<std::atomic<uint64_t>[]> m_reprojectionTargets; ///< Per-pixel depth and source pixel index of the closest reprojected hit, packed for atomic depth testing
+
+        bool m_valid = false; ///< Whether the record and the framebuffer hold a complete image of the history view
+        glm::vec3 m_cameraPosition; ///< Camera position of the history view
+        glm::vec3 m_cameraDirection; ///< Camera look direction of the history view
+        float m_cameraFOV = 0.0f; ///< Camera field of view of the history view
+        float m_nearClippingPlane = 0.0f; ///< Camera near clipping plane distance of the history view
+        float m_farClippingPlane = 0.0f; ///< Camera far clipping plane distance of the history view
+        uint32_t m_shading = 0; ///< Shading settings the history view has been rendered with
+        glm::vec3 m_lightPositions[yart::World::LIGHT_COUNT]; ///< Light positions the history view has been rendered with
+
+    };
+} // namespace yart
@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of the RenderScene class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "render_scene.h"
+
+
+#include "yart/common/utils/yart_utils.h"
+
+
+namespace yart
+{
+    /// @brief Check whether two render objects have the same world-space geometry
+    /// @details World-space triangles are baked from the mesh and the transform, so they are compared by those rather than by their buffers
+    /// @param a First render object
+    /// @param b Second render object
+    /// @return Whether the objects are of the same type, with the same transform and shape
+    static bool GeometryEqual(const RenderObject& a, const RenderObject& b)
+    {
+        return a.id == b.id && a.type == b.type && a.position == b.position && a.inverseScale == b.inverseScale && a.radius == b.radius 
+            && a.meshBVH == b.meshBVH;
+    }
+
+    /// @brief Check whether two render objects have the same material
+    /// @param a First render object
+    /// @param b Second render object
+    /// @return Whether all material parameters of the objects are equal
+    static bool MaterialEqual(const RenderObject& a, const RenderObject& b)
+    {
+        return a.materialColor == b.materialColor && a.materialDiffuse == b.materialDiffuse && a.materialSpecular == b.materialSpecular 
+            && a.materialSpecularFalloff == b.materialSpecularFalloff && a.materialReflection == b.materialReflection;
+    }
+
+
+    RenderScene::RenderScene(std::vector<RenderObject> objects, uint64_t version, const RenderScene* previous)
+        : m_objects(std::move(objects)), m_version(version)
+    {
+        // Material edits leave the object bounds untouched, so the top-level hierarchy of the previous version can be shared
+        if (previous != nullptr && previous->HasSameGeometry(m_objects)) {
+            m_tlas = previous->m_tlas;
+            return;
+        }
+
+        std::vector<AABB> bounds(m_objects.size());
+        for (size_t i = 0; i < m_objects.size(); ++i)
+            bounds[i] = ComputeObjectBounds(m_objects[i]);
+
+        std::shared_ptr<yart::BVH> tlas = std::make_shared<yart::BVH>();
+        tlas->Build(bounds.data(), static_cast<uint32_t>(bounds.size()));
+        m_tlas = std::move(tlas);
+    }
+
+    bool RenderScene::HasSameGeometry(const std::vector<RenderObject>& objects) const
+    {
+        if (objects.size() != m_objects.size())
+            return false;
+
+        for (size_t i = 0; i < objects.size(); ++i) {
+            if (!GeometryEqual(objects[i], m_objects[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool RenderScene::HasSameObjects(const std::vector<RenderObject>& objects) const
+    {
+        if (!HasSameGeometry(objects))
+            return false;
+
+        for (size_t i = 0; i < objects.size(); ++i) {
+            if (!MaterialEqual(objects[i], m_objects[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool RenderScene::FindChangedObjects(const RenderScene& previous, std::vector<RenderObjectChange>& changes) const
+    {
+        changes.clear();
+        if (previous.m_objects.size() != m_objects.size())
+            return false;
+
+        for (size_t i = 0; i < m_objects.size(); ++i) {
+            if (previous.m_objects[i].id != m_objects[i].id) {
+                changes.clear();
+                return false;
+            }
+
+            const bool geometry_changed = !GeometryEqual(previous.m_objects[i], m_objects[i]);
+            if (geometry_changed || !MaterialEqual(previous.m_objects[i], m_objects[i]))
+                changes.push_back({ i, geometry_changed });
+        }
+
+        return true;
+    }
+
+    AABB RenderScene::ComputeObjectBounds(const RenderObject& object)
+    {
+        AABB bounds;
+        switch (object.type) {
+        case ObjectType::MESH: {
+            YART_ASSERT(object.meshBVH != nullptr && !object.meshBVH->IsEmpty());
+
+            // Transformations are limited to scale and translation, so the transformed corners still bound the mesh
+            const AABB local_bounds = object.meshBVH->GetBounds();
+            bounds.Grow(local_bounds.min / object.inverseScale + object.position);
+            bounds.Grow(local_bounds.max / object.inverseScale + object.position);
+            break;
+        }
+        case ObjectType::SDF: {
+            const glm::vec3 radius = glm::vec3(glm::abs(object.radius));
+            bounds.Grow(object.position - radius);
+            bounds.Grow(object.position + radius);
+            break;
+        }
+        default:
+            YART_UNREACHABLE();
+        }
+
+        return bounds;
+    }
+
+    float RenderScene::IntersectRay(const Ray& ray, const RenderObject** hit_obj, bool uv, glm::vec3& out, float t_max, glm::vec2* barycentrics) const
+    {
+        float min_dist = t_max;
+
+        const RenderObject* hit_object = nullptr;
+        uint32_t hit_triangle = 0;
+        float hit_u = 0.0f, hit_v = 0.0f;
+
+        m_tlas->Traverse(ray, min_dist, [&](uint32_t i) {
+            const RenderObject* obj = &m_objects[i];
+
+            switch (obj->type) {
+            case ObjectType::MESH: {
+                // Traverse the mesh hierarchy in object space and test the cached world-space triangles of each leaf.
+                // Hit distances are equal in both spaces, as the object-space ray direction is not renormalized
+                const yart::Ray local_ray = WorldToObjectRay(*obj, ray);
+                const yart::TriangleSoA& triangles = *obj->worldTriangles;
+
+                obj->meshBVH->TraverseLeaves(local_ray, min_dist, [&](uint32_t first, uint32_t count) {
+                    float t, u, v;
+                    uint32_t tri;
+                    if (yart::Ray::IntersectTriangles(ray, triangles, first, count, min_dist, &t, &u, &v, &tri)) {
+                        hit_object = obj;
+                        hit_triangle = tri;
+                        min_dist = t;
+                        hit_u = u;
+                        hit_v = v;
+                    }
+
+                    return false;
+                });
+                break;
+            }
+            case ObjectType::SDF: {
+                float t;
+                if (IntersectSdf(*obj, ray, min_dist, &t)) {
+                    hit_object = obj;
+                    min_dist = t;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+
+            return false;
+        });
+
+        *hit_obj = hit_object;
+        if (hit_object == nullptr) 
+            return -1.0f;
+
+        // Compute the surface attributes only once, for the closest hit
+        GetSurfaceAttributes(*hit_object, ray, min_dist, hit_triangle, hit_u, hit_v, uv, out);
+        if (barycentrics != nullptr)
+            *barycentrics = { hit_u, hit_v };
+
+        return min_dist;
+    }
+
+    void RenderScene::IntersectPacket(const RayPacket& packet, const RenderObject** hit_objs, bool uv, glm::vec3* out, float* distances, float t_max, glm::vec2* barycentrics) const
+    {
+        YART_ASSERT(packet.count <= RayPacket::SIZE);
+
+        // Rays pointing into different octants share little of their traversal, so they are better off traced on their own
+        if (!packet.IsCoherent()) {
+            for (uint32_t i = 0; i < packet.count; ++i)
+                distances[i] = IntersectRay(packet.rays[i], &hit_objs[i], uv, out[i], t_max, barycentrics != nullptr ? &barycentrics[i] : nullptr);
+
+            return;
+        }
+
+        float min_dist[RayPacket::SIZE];
+        const RenderObject* hit_object[RayPacket::SIZE];
+        uint32_t hit_triangle[RayPacket::SIZE];
+        float hit_u[RayPacket::SIZE], hit_v[RayPacket::SIZE];
+
+        for (uint32_t i = 0; i < packet.count; ++i) {
+            min_dist[i] = t_max;
+            hit_object[i] = nullptr;
+            hit_triangle[i] = 0;
+            hit_u[i] = hit_v[i] = 0.0f;
+        }
+
+        const uint32_t packet_mask = packet.count == 32 ? ~0U : (1U << packet.count) - 1;
+        const uint32_t* tlas_indices = m_tlas->GetPrimitiveIndices();
+
+        m_tlas->TraversePacket(packet.rays, packet_mask, min_dist, [&](uint32_t first, uint32_t count, uint32_t mask) {
+            for (uint32_t p = first; p < first + count; ++p) {
+                const RenderObject* obj = &m_objects[tlas_indices[p]];
+
+                switch (obj->type) {
+                case ObjectType::MESH: {
+                    yart::Ray local_rays[RayPacket::SIZE];
+                    for (uint32_t i = 0; i < packet.count; ++i) {
+                        if (mask & (1U << i))
+                            local_rays[i] = WorldToObjectRay(*obj, packet.rays[i]);
+                    }
+
+                    const yart::TriangleSoA& triangles = *obj->worldTriangles;
+                    obj->meshBVH->TraversePacket(local_rays, mask, min_dist, [&](uint32_t leaf_first, uint32_t leaf_count, uint32_t leaf_mask) {
+                        for (uint32_t i = 0; i < packet.count; ++i) {
+                            if ((leaf_mask & (1U << i)) == 0)
+                                continue;
+
+                            float t, u, v;
+                            uint32_t tri;
+                            if (yart::Ray::IntersectTriangles(packet.rays[i], triangles, leaf_first, leaf_count, min_dist[i], &t, &u, &v, &tri)) {
+                                hit_object[i] = obj;
+                                hit_triangle[i] = tri;
+                                min_dist[i] = t;
+                                hit_u[i] = u;
+                                hit_v[i] = v;
+                            }
+                        }
+                    });
+                    break;
+                }
+                case ObjectType::SDF: {
+                    for (uint32_t i = 0; i < packet.count; ++i) {
+                        float t;
+                        if ((mask & (1U << i)) && IntersectSdf(*obj, packet.rays[i], min_dist[i], &t)) {
+                            hit_object[i] = obj;
+                            min_dist[i] = t;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+        });
+
+        for (uint32_t i = 0; i < packet.count; ++i) {
+            hit_objs[i] = hit_object[i];
+            if (hit_object[i] == nullptr) {
+                distances[i] = -1.0f;
+                continue;
+            }
+
+            GetSurfaceAttributes(*hit_object[i], packet.rays[i], min_dist[i], hit_triangle[i], hit_u[i], hit_v[i], uv, out[i]);
+            distances[i] = min_dist[i];
+            if (barycentrics != nullptr)
+                barycentrics[i] = { hit_u[i], hit_v[i] };
+        }
+    }
+
+    bool RenderScene::Occluded(const Ray& ray, float t_min, float t_max) const
+    {
+        if (t_min >= t_max)
+            return false;
+
+        // Move the ray origin to the start of the interval, so that all intersection tests only have to respect `t_max`
+        yart::Ray segment = ray;
+        segment.origin = ray.origin + t_min * ray.direction;
+        const float segment_length = t_max - t_min;
+
+        float hit_dist = segment_length;
+        return m_tlas->Traverse(segment, segment_length, [&](uint32_t i) {
+            const RenderObject* obj = &m_objects[i];
+
+            switch (obj->type) {
+            case ObjectType::MESH: {
+                const yart::Ray local_ray = WorldToObjectRay(*obj, segment);
+                const yart::TriangleSoA& triangles = *obj->worldTriangles;
+
+                return obj->meshBVH->TraverseLeaves(local_ray, segment_length, [&](uint32_t first, uint32_t count) {
+                    float u, v;
+                    uint32_t tri;
+                    return yart::Ray::IntersectTriangles(segment, triangles, first, count, segment_length, &hit_dist, &u, &v, &tri);
+                });
+            }
+            case ObjectType::SDF:
+                return IntersectSdf(*obj, segment, segment_length, &hit_dist);
+            default:
+                return false;
+            }
+        });
+    }
+
+    yart::Ray RenderScene::WorldToObjectRay(const RenderObject& object, const yart::Ray& ray)
+    {
+        yart::Ray local_ray;
+        local_ray.origin = (ray.origin - object.position) * object.inverseScale;
+        local_ray.direction = ray.direction * object.inverseScale;
+
+        return local_ray;
+    }
+
+    bool RenderScene::IntersectSdf(const RenderObject& object, const yart::Ray& ray, float t_max, float* t)
+    {
+        const float radius = object.radius;
+        const glm::vec3 dir = ray.origin - object.position; 
+        const float dir_len = glm::length(dir);
+
+        const float a = 1.0f;
+        const float half_b = glm::dot(dir, ray.direction);
+        const float c = dir_len * dir_len - radius * radius;
+        const float discriminant = half_b * half_b - a * c;
+
+        if (discriminant < 0) 
+            return false;
+
+        const float dist = -half_b - glm::sqrt(discriminant);
+        if (dist <= 0.0f || dist >= t_max)
+            return false;
+
+        *t = dist;
+        return true;
+    }
+
+    void RenderScene::GetSurfaceAttributes(const RenderObject& object, const yart::Ray& ray, float distance, uint32_t triangle, float u, float v, bool uv, glm::vec3& out)
+    {
+        if (object.type == ObjectType::MESH) {
+            if (uv) {
+                // const float w = 1 - (*u) - (*v);
+                // const glm::u32vec3& uv_indices = obj.triangleUVs[i];
+                // const glm::vec2 tex_uv = w * obj.UVs[uv_indices.x] + (*u) * obj.UVs[uv_indices.y] + (*v) * obj.UVs[uv_indices.z];
+                out.x = u;
+                out.y = v;
+                out.z = 0.0f;
+            } else {
+                // Use the precomputed surface normal vector
+                out = object.worldTriangles->GetNormal(triangle);
+            }
+        } else {
+            const glm::vec3 hit_pos = ray.origin + distance * ray.direction;
+            out = glm::normalize(hit_pos - object.position);
+        }
+    }
+} // namespace yart
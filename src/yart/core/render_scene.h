@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the RenderScene class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "yart/common/utils/yart_utils.h"
+#include "yart/core/triangles.h"
+#include "yart/core/object.h"
+#include "yart/core/bvh.h"
+#include "yart/core/ray.h"
+
+
+namespace yart
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Flattened copy of a scene object, holding only the data required for rendering
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct RenderObject {
+    public:
+        Object::id_t id; ///< ID of the scene object this render object has been compiled from
+        ObjectType type; ///< Underlying type of the object
+
+        glm::vec3 position; ///< Object origin position in world-space
+        glm::vec3 inverseScale; ///< Reciprocal of the object scale for each axis, used for transforming rays into object space
+        float radius; ///< World-space sphere radius. Valid only for ObjectType::SDF objects
+
+        std::shared_ptr<const yart::BVH> meshBVH; ///< Object-space bottom-level BVH over the mesh triangles. Valid only for ObjectType::MESH objects
+        std::shared_ptr<const yart::TriangleSoA> worldTriangles; ///< World-space mesh triangles in the leaf order of `meshBVH`. Valid only for ObjectType::MESH objects
+
+        glm::vec3 materialColor; ///< Solid color of the object's material
+        float materialDiffuse; ///< Diffuse coefficient of the object's material
+        float materialSpecular; ///< Specular reflectance coefficient of the object's material
+        float materialSpecularFalloff; ///< Specular falloff exponent of the object's material
+        float materialReflection; ///< Reflection strength of the object's material
+
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Object changed in between two versions of a scene
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct RenderObjectChange {
+    public:
+        size_t index; ///< Index of the object in both versions of the scene
+        bool geometryChanged; ///< Whether the world-space geometry of the object has changed, rather than just its material
+
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Immutable snapshot of a scene, compiled from the editable yart::Scene for rendering
+    /// @details All objects are stored in a single contiguous array, with their transforms and world-space
+    ///     triangles baked in, together with a top-level BVH over their bounds. Since a snapshot is never
+    ///     modified after construction, any number of threads can issue ray queries against it without synchronization.
+    ///     
+    ///     Snapshots act as reference counted versions of the scene, each one kept alive for as long as any frame renders it.
+    ///     Consecutive versions are copy-on-write: mesh hierarchies, triangles and the top-level hierarchy are shared 
+    ///     with the previous version, unless the edits made in between have changed them
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    class RenderScene {
+    public:
+        /// @brief Construct a new scene snapshot and build its top-level acceleration structure
+        /// @param objects Compiled scene objects. Mesh objects are expected to have a non-empty BVH
+        /// @param version Version number of the snapshot, increasing with each published snapshot of a scene
+        /// @param previous Optional previous version of the scene, whose top-level hierarchy is reused if the object geometry has not changed
+        RenderScene(std::vector<RenderObject> objects, uint64_t version, const RenderScene* previous = nullptr);
+
+        RenderScene(const RenderScene&) = delete;
+        RenderScene& operator=(RenderScene const&) = delete;
+
+        /// @brief Get the version number of the snapshot
+        /// @return Scene version
+        uint64_t GetVersion() const
+        {
+            return m_version;
+        }
+
+        /// @brief Check whether a list of compiled objects is identical to the objects of the snapshot
+        /// @param objects Compiled scene objects
+        /// @return Whether a snapshot of the objects would render exactly the same as this one
+        bool HasSameObjects(const std::vector<RenderObject>& objects) const;
+
+        /// @brief Get the objects of the snapshot
+        /// @param count Output parameter set to the number of objects
+        /// @return Array of render objects
+        const RenderObject* GetObjects(size_t* count) const
+        {
+            *count = m_objects.size();
+            return m_objects.data();
+        }
+
+        /// @brief Get the world-space bounds of an object of the snapshot
+        /// @param index Index of the object in the array returned from RenderScene::GetObjects()
+        /// @return Axis-aligned bounding box of the object
+        yart::AABB GetObjectBounds(size_t index) const
+        {
+            YART_ASSERT(index < m_objects.size());
+            return ComputeObjectBounds(m_objects[index]);
+        }
+
+        /// @brief Find the objects which have changed since a previous version of the scene
+        /// @param previous Previous version of the scene
+        /// @param changes Output vector, cleared and filled with the changed objects
+        /// @return Whether both versions hold the same objects in the same order, so that they can be compared one by one. 
+        ///     If not, `changes` is left empty
+        bool FindChangedObjects(const RenderScene& previous, std::vector<RenderObjectChange>& changes) const;
+
+        /// @brief Test for ray-scene intersections
+        /// @param ray Ray to be intersected with the scene
+        /// @param hit_obj Pointer to the nearest hit object, or `nullptr` on miss
+        /// @param uv Wether uv coordinates should be returned instead of the surface normal
+        /// @param out Output parameter set with either the surface normal or uvs
+        /// @param t_max Distance from the ray's origin, beyond which hits are ignored
+        /// @param barycentrics Optional output parameter set with the barycentric coordinates of the hit triangle, or zero for SDF hits
+        /// @return Distance to the closest object hit, or a negative value on miss
+        float IntersectRay(const Ray& ray, const RenderObject** hit_obj, bool uv, glm::vec3& out,
+            float t_max = std::numeric_limits<float>::infinity(), glm::vec2* barycentrics = nullptr) const;
+
+        /// @brief Test for scene intersections of a packet of rays, sharing the acceleration structure traversal between all rays
+        /// @details Incoherent packets, with rays pointing into different octants, fall back to RenderScene::IntersectRay() for each ray
+        /// @param packet Rays to be intersected with the scene
+        /// @param hit_objs Output array of pointers to the nearest hit object of each ray, or `nullptr` on miss
+        /// @param uv Wether uv coordinates should be returned instead of the surface normals
+        /// @param out Output array set with either the surface normal or uvs of each ray
+        /// @param distances Output array of distances to the closest object hit of each ray, or a negative value on miss
+        /// @param t_max Distance from the rays' origin, beyond which hits are ignored
+        /// @param barycentrics Optional output array set with the barycentric coordinates of each ray's hit triangle, or zero for SDF hits
+        void IntersectPacket(const RayPacket& packet, const RenderObject** hit_objs, bool uv, glm::vec3* out, float* distances,
+            float t_max = std::numeric_limits<float>::infinity(), glm::vec2* barycentrics = nullptr) const;
+
+        /// @brief Test whether any object in the scene intersects a ray segment
+        /// @details Unlike RenderScene::IntersectRay(), the traversal terminates on the first hit found,
+        ///     and no surface attributes are computed. Suited for visibility queries which do not depend on the distance to the occluder
+        /// @param ray Ray to be intersected with the scene
+        /// @param t_min Distance from the ray's origin, from which hits are considered
+        /// @param t_max Distance from the ray's origin, beyond which hits are ignored
+        /// @return Whether any object has been hit in the (t_min, t_max) range
+        bool Occluded(const Ray& ray, float t_min, float t_max) const;
+
+    private:
+        /// @brief Check whether a list of compiled objects has the same world-space geometry as the objects of the snapshot
+        /// @param objects Compiled scene objects
+        /// @return Whether the top-level hierarchy of this snapshot is valid for the objects
+        bool HasSameGeometry(const std::vector<RenderObject>& objects) const;
+
+        /// @brief Compute the world-space bounds of a render object
+        /// @param object Render object. Mesh objects are expected to have a non-empty BVH
+        /// @return Axis-aligned bounding box of the object
+        static yart::AABB ComputeObjectBounds(const RenderObject& object);
+
+        /// @brief Transform a world-space ray into the object space of a given object
+        /// @details Direction vectors are not renormalized, so that hit distances are preserved between spaces
+        /// @param object Render object
+        /// @param ray World-space ray
+        /// @return Object-space ray
+        static yart::Ray WorldToObjectRay(const RenderObject& object, const yart::Ray& ray);
+
+        /// @brief Ray-SDF sphere intersection check
+        /// @param object SDF type render object
+        /// @param ray World-space ray
+        /// @param t_max Distance from the ray's origin, beyond which hits are ignored
+        /// @param t Output parameter set on valid intersection with distance from the ray's origin to the intersection point
+        /// @return Whether the ray intersected with the object in the (0, t_max) range
+        static bool IntersectSdf(const RenderObject& object, const yart::Ray& ray, float t_max, float* t);
+
+        /// @brief Compute the surface attributes of a ray-object hit
+        /// @param object Hit object
+        /// @param ray World-space ray
+        /// @param distance Distance from the ray's origin to the hit point
+        /// @param triangle Index of the hit triangle in the object's world-space triangle storage. Ignored for SDF objects
+        /// @param u Barycentric u parameter of the hit. Ignored for SDF objects
+        /// @param v Barycentric v parameter of the hit. Ignored for SDF objects
+        /// @param uv Wether uv coordinates should be returned instead of the surface normal
+        /// @param out Output parameter set with either the surface normal or uvs
+        static void GetSurfaceAttributes(const RenderObject& object, const yart::Ray& ray, float distance,
+            uint32_t triangle, float u, float v, bool uv, glm::vec3& out);
+
+    private:
+        std::vector<RenderObject> m_objects; ///< Contiguous array of all rendered objects
+        std::shared_ptr<const yart::BVH> m_tlas; ///< Top-level bounding volume hierarchy over world-space object bounds, indexing into `m_objects`
+        uint64_t m_version; ///< Version number of the snapshot
+
+    };
+} // namespace yart
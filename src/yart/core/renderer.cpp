@@ -7,6 +7,9 @@
 
 
 #include <algorithm>
+#include <cstring>
+#include <atomic>
+#include <chrono>
 
 #include <imgui.h>
 
@@ -23,51 +26,920 @@
 
 namespace yart
 {
-    bool Renderer::Render(yart::Camera& camera, float buffer[], uint32_t width, uint32_t height)
+    /// @brief Compute the radical inverse of an integer in a given base, i.e. an element of the Halton sequence
+    /// @param base Prime base of the sequence
+    /// @param index Index of the sequence element
+    /// @return Sequence element in the [0, 1) range
+    static float RadicalInverse(uint32_t base, uint32_t index)
+    {
+        const float inv_base = 1.0f / static_cast<float>(base);
+
+        float result = 0.0f;
+        float scale = inv_base;
+        while (index > 0) {
+            result += static_cast<float>(index % base) * scale;
+            index /= base;
+            scale *= inv_base;
+        }
+
+        return result;
+    }
+
+
+    /// @brief Compute the relative luminance of a linear RGB color
+    /// @param rgb Pointer to three consecutive color channels
+    /// @return Luminance value
+    static float Luminance(const float* rgb)
+    {
+        return 0.2126f * rgb[0] + 0.7152f * rgb[1] + 0.0722f * rgb[2];
+    }
+
+
+    /// @brief Build the primary camera ray through a given pixel
+    /// @param origin Camera position
+    /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+    /// @param width Width in pixels of the output image
+    /// @param x Horizontal pixel coordinate
+    /// @param y Vertical pixel coordinate
+    /// @param jitter Subpixel offset of the ray in the `[-0.5, 0.5)` range
+    /// @return Primary ray, along with its direction differentials
+    static yart::Ray PrimaryRay(const glm::vec3& origin, const glm::vec3* ray_directions, uint32_t width, uint32_t x, uint32_t y, const glm::vec2& jitter)
+    {
+        const size_t i = static_cast<size_t>(y) * width + x;
+
+        glm::vec3 ray_direction           = ray_directions[i];
+        const glm::vec3 ray_direction_ddx = ray_directions[i + 1];
+        const glm::vec3 ray_direction_ddy = ray_directions[i + width];
+
+        if (jitter.x != 0.0f || jitter.y != 0.0f) {
+            // The cache wraps around at the end of each row, so the last column uses its left neighbour instead
+            const glm::vec3 step_x = x + 1 < width ? ray_direction_ddx - ray_direction : (x > 0 ? ray_direction - ray_directions[i - 1] : glm::vec3(0.0f));
+            const glm::vec3 step_y = ray_direction_ddy - ray_direction;
+            ray_direction = glm::normalize(ray_direction + jitter.x * step_x + jitter.y * step_y);
+        }
+
+        return { origin, ray_direction, ray_direction_ddx, ray_direction_ddy };
+    }
+
+
+    /// @brief Test whether a line segment crosses an axis-aligned bounding box
+    /// @param origin Start point of the segment
+    /// @param direction Normalized direction of the segment
+    /// @param length Length of the segment
+    /// @param bounds Bounding box
+    /// @return Whether any point of the segment lies within the box
+    static bool SegmentIntersectsBounds(const glm::vec3& origin, const glm::vec3& direction, float length, const yart::AABB& bounds)
+    {
+        const yart::Ray ray = { origin, direction, direction, direction };
+
+        float distance;
+        return yart::Ray::IntersectAABB(ray, 1.0f / direction, bounds.min, bounds.max, length, &distance);
+    }
+
+
+    Renderer::~Renderer()
+    {
+        StopRenderThread();
+    }
+
+    void Renderer::RequestFrame(const yart::Camera& camera, uint32_t width, uint32_t height, uint32_t output_width, uint32_t output_height, bool reset)
+    {
+        YART_ASSERT(m_scene != nullptr);
+
+        {
+            std::lock_guard<std::mutex> lock(m_renderMutex);
+            m_requestedCamera.CopyView(camera);
+            m_requestedScene = m_scene->GetRenderScene();
+            m_requestedWorld = *m_world;
+            m_requestedSettings = m_settings;
+            m_requestedWidth = width;
+            m_requestedHeight = height;
+            m_requestedOutputWidth = output_width;
+            m_requestedOutputHeight = output_height;
+            m_frameResetRequested |= reset; // Coalesced requests must not drop a pending reset
+            m_frameRequested = true;
+
+            // Frames refining a view which has just changed, or rendered at a size which would be dropped on presentation, are obsolete. 
+            // Frames holding the first sample of their view are always finished, so that the image keeps updating during continuous camera motion
+            const bool resized = width != m_inFlightWidth || height != m_inFlightHeight 
+                || output_width != m_inFlightOutputWidth || output_height != m_inFlightOutputHeight;
+            if (resized || (reset && m_inFlightRefines))
+                m_frameCancellation.Cancel();
+        }
+
+        if (!m_renderThread.joinable())
+            m_renderThread = std::thread(&Renderer::RenderThreadMain, this);
+
+        m_renderCondition.notify_one();
+    }
+
+    bool Renderer::PresentFrame(yart::Viewport& viewport)
+    {
+        if (!m_frameImages.Acquire())
+            return false;
+
+        // The acquired image is owned by this thread until the next call, so it can be copied without holding up the render thread
+        const FrameImage& frame = m_frameImages.GetReadBuffer();
+        m_presentedFrameSamples = frame.samples;
+        m_presentedFrameTime = frame.renderTime;
+        m_presentedFramePartial = frame.partial;
+
+        // The viewport might have been resized since the frame was requested
+        const ImVec2 image_size = viewport.GetImageSize();
+        if (frame.width != static_cast<uint32_t>(image_size.x) || frame.height != static_cast<uint32_t>(image_size.y))
+            return false;
+
+        std::memcpy(viewport.GetImageData(), frame.data.data(), frame.data.size() * sizeof(float));
+        return true;
+    }
+
+    void Renderer::StopRenderThread()
+    {
+        if (!m_renderThread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_renderMutex);
+            m_renderThreadShouldStop = true;
+        }
+
+        m_renderCondition.notify_one();
+        m_renderThread.join();
+
+        m_renderThreadShouldStop = false;
+    }
+
+    void Renderer::RenderThreadMain()
+    {
+        while (true) {
+            uint32_t width, height, output_width, output_height;
+            {
+                std::unique_lock<std::mutex> lock(m_renderMutex);
+                m_renderCondition.wait(lock, [this] { return m_frameRequested || m_renderThreadShouldStop; });
+                if (m_renderThreadShouldStop)
+                    return;
+
+                // Take over the latest request, so that the UI thread can keep modifying its own camera, world and settings while the frame renders. 
+                // The scene snapshot is taken over as well, so that a version published after the request is not rendered before the reset requested with it
+                m_renderCamera.CopyView(m_requestedCamera);
+                m_frameScene = std::move(m_requestedScene);
+                m_renderWorld = m_requestedWorld;
+                m_renderSettings = m_requestedSettings;
+                width = m_requestedWidth;
+                height = m_requestedHeight;
+                output_width = m_requestedOutputWidth;
+                output_height = m_requestedOutputHeight;
+                m_frameRequested = false;
+
+                if (m_frameResetRequested) {
+                    ResetAccumulation();
+                    m_frameResetRequested = false;
+                }
+
+                m_frameCancellation.Reset();
+                m_inFlightWidth = width;
+                m_inFlightHeight = height;
+                m_inFlightOutputWidth = output_width;
+                m_inFlightOutputHeight = output_height;
+                m_inFlightRefines = m_accumulatedFrames > 0 || m_previewStride != m_previewInitialStride;
+            }
+
+            FrameImage& frame = m_frameImages.GetWriteBuffer();
+            frame.data.resize(static_cast<size_t>(output_width) * output_height * yart::Framebuffer::CHANNELS);
+
+            // Renders smaller than the output are made into a separate buffer first, and upscaled into the frame afterwards
+            const bool upscale = width != output_width || height != output_height;
+            if (upscale)
+                m_upscaleSource.resize(static_cast<size_t>(width) * height * yart::Framebuffer::CHANNELS);
+
+            // Nothing has been written to the image, the latest published one is still up to date
+            const auto start_time = std::chrono::steady_clock::now();
+            if (!Render(m_renderCamera, upscale ? m_upscaleSource.data() : frame.data.data(), width, height, &m_frameCancellation))
+                continue;
+
+            // Only the render scales with the rendered image size. Upscaling into the output, including its guides, costs the same at any resolution scale
+            const float render_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count();
+
+            if (upscale) {
+                // Guides only depend on the view and the scene geometry, which invalidate the accumulated samples as well
+                if (m_upscaleGuidesOutdated) {
+                    m_upscaler.DiscardGuides();
+                    m_upscaleGuidesOutdated = false;
+                }
+
+                // Tracing the guides at the output resolution costs more than the low resolution render itself, so while the view 
+                // or the scene keeps changing frames are upscaled bilinearly, and the guides are traced once further samples are accumulated
+                if (m_accumulatedFrames > 1 && !m_upscaler.HasGuides(width, height, output_width, output_height)) {
+                    m_upscaleCamera.CopyView(m_renderCamera);
+                    m_upscaler.UpdateGuides(*m_renderScene, m_renderCamera, width, height, m_upscaleCamera, output_width, output_height);
+                }
+
+                m_upscaler.Upscale(m_upscaleSource.data(), width, height, frame.data.data(), output_width, output_height);
+            }
+
+            frame.width = output_width;
+            frame.height = output_height;
+            frame.samples = m_accumulatedFrames;
+            frame.partial = m_framePartial;
+            frame.renderTime = render_time;
+            m_frameImages.Publish();
+        }
+    }
+
+    bool Renderer::Render(yart::Camera& camera, float buffer[], uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation)
     {
         YART_ASSERT(buffer != nullptr);
         YART_ASSERT(m_scene != nullptr);
 
+        // Pick up the scene snapshot of the frame, which is kept alive and unchanged until the next one is picked up
+        std::shared_ptr<const yart::RenderScene> render_scene = m_frameScene;
+        YART_ASSERT(render_scene != nullptr);
+
+        // The snapshot the history has been rendered with is kept until the first frame of the new one decides whether to update it sparsely
+        std::shared_ptr<const yart::RenderScene> previous_scene;
+        if (m_renderScene == nullptr || render_scene->GetVersion() != m_renderScene->GetVersion()) {
+            previous_scene = std::move(m_renderScene);
+            m_renderScene = std::move(render_scene);
+            ResetAccumulation();
+        }
+
         bool dirty;
         const glm::vec3* ray_directions = camera.GetRayDirections(width, height, &dirty);
 
-        // Multithreaded iteration through all image pixels
-        yart::threads::parallel_for<size_t>(0, width * height, [&](size_t i) {
-            const auto [y, x] = std::div(i, static_cast<int64_t>(width));
+        if (m_framebuffer.Resize(width, height)) {
+            m_sampleMoments.resize(m_framebuffer.GetStoredPixelCount());
+            m_tileConverged.resize(static_cast<size_t>(m_framebuffer.GetTileCountX()) * m_framebuffer.GetTileCountY());
+
+            m_history.Resize(width, height);
+            m_overlayLayer.resize(static_cast<size_t>(width) * height);
+            m_overlayLayerValid = false;
+
+            ResetAccumulation();
+        }
+
+        // Once converged, the output buffer already holds the final image
+        if (m_accumulatedFrames >= MAX_ACCUMULATED_FRAMES)
+            return dirty;
 
-            const glm::vec3 ray_direction     = ray_directions[i];
-            const glm::vec3 ray_direction_ddx = ray_directions[(y + 0) * width + x + 1];
-            const glm::vec3 ray_direction_ddy = ray_directions[(y + 1) * width + x + 0];
+        // Overlays only depend on the view, so they are sampled once and composited over the primary rays of all following frames. 
+        // The ray directions they are sampled along change with the image size, the look direction, the field of view and the near clipping plane
+        if (dirty)
+            m_overlayLayerValid = false;
 
-            // Trace a ray from the camera's origin into the scene
-            HitPayload payload;
-            const yart::Ray ray = { camera.position, ray_direction, ray_direction_ddx, ray_direction_ddy };
-            TraceRay(camera, ray, payload, 1);
+        const bool overlay_view = camera.position == m_overlayCameraPosition && camera.GetLookDirection() == m_overlayCameraDirection 
+            && camera.GetFOV() == m_overlayCameraFOV && camera.GetNearClippingPlane() == m_overlayNearClippingPlane;
+        if (m_renderSettings.showOverlays && (!m_overlayLayerValid || !overlay_view || m_renderSettings.useThickerGrid != m_overlayThickerGrid))
+            UpdateOverlayLayer(camera, ray_directions, width, height);
 
-            buffer[i * 4 + 0] = payload.resultColor.r;
-            buffer[i * 4 + 1] = payload.resultColor.g;
-            buffer[i * 4 + 2] = payload.resultColor.b;
-            buffer[i * 4 + 3] = 1.0f;
+        m_framePartial = false;
+        const bool history_view = m_accumulatedFrames == 0 && m_history.IsView(camera);
+
+        // Hits recorded for another view or projection can only be reprojected, never reshaded or recomposited in place
+        if (m_accumulatedFrames == 0 && !history_view && !CanReproject(camera))
+            m_history.Invalidate();
+
+        if (previous_scene != nullptr) {
+            if (!history_view || !GatherObjectEdits(*previous_scene)) {
+                // The history has been recorded with the previous snapshot
+                m_history.Invalidate();
+            } else if (m_renderSettings.sparseUpdates && IsHistoryShading()) {
+                // When only some objects have changed, the first frame of the new snapshot updates just the pixels whose rays might have touched them
+                return FinishHistoryFrame(RenderSparse(camera, ray_directions, width, height, cancellation), buffer);
+            } else if (m_editsChangeGeometry) {
+                m_history.Invalidate();
+            }
+        }
+
+        // When only the lighting parameters have changed, the first frame recomposites the recorded radiance decompositions. 
+        // The decompositions are only valid for the exact view they have been recorded in, including its projection
+        if (history_view && m_history.IsValid() && previous_scene == nullptr && m_renderSettings.lightingRecomposition && IsHistoryShading())
+            return FinishHistoryFrame(RenderRecomposited(width, height, cancellation), buffer);
+
+        // When neither the view nor the scene geometry has changed, the first frame reshades the recorded primary hits without tracing them
+        if (history_view && m_history.IsValid() && m_renderSettings.deferredShading)
+            return FinishHistoryFrame(RenderReshaded(camera, ray_directions, width, height, cancellation), buffer);
+
+        // When only the view has changed, the first frame reprojects the previous image into the new view, and traces only the pixels it could not fill
+        if (m_accumulatedFrames == 0 && CanReproject(camera))
+            return FinishHistoryFrame(RenderReprojected(camera, ray_directions, width, height, cancellation), buffer);
+
+        // After a reset, the view is first previewed with coarse passes of decreasing block size, each splatting a single ray over a block of pixels
+        if (m_previewStride > 1) {
+            yart::threads::parallel_for_2d_blocked(width, height, yart::Framebuffer::TILE_SIZE, [&](const yart::threads::Tile& tile) {
+                if (cancellation != nullptr && cancellation->IsCancelled())
+                    return;
+
+                RenderPreviewTile(camera, ray_directions, width, m_previewStride, tile);
+            });
+
+            // Splatted previews overwrite the previous image
+            m_history.Invalidate();
+
+            if (cancellation != nullptr && cancellation->IsCancelled()) {
+                ResetAccumulation();
+                return false;
+            }
+
+            m_previewStride /= 2;
+            m_framebuffer.Resolve(buffer);
+
+            return true;
+        }
+
+        // The first frame samples pixel centers, following frames are jittered within the pixel footprint
+        const glm::vec2 jitter = m_accumulatedFrames == 0 ? glm::vec2(0.0f) : glm::vec2(
+            RadicalInverse(2, m_accumulatedFrames) - 0.5f, 
+            RadicalInverse(3, m_accumulatedFrames) - 0.5f
+        );
+
+        // Multithreaded, load-balanced iteration through image tiles in Z-order, accumulated into the tiled framebuffer
+        std::atomic<uint32_t> rendered_tiles { 0 };
+        const auto start_time = std::chrono::steady_clock::now();
+
+        // The first frame records the primary hits of the view, which are incomplete until the frame is done
+        if (m_accumulatedFrames == 0)
+            m_history.Invalidate();
+
+        yart::threads::parallel_for_2d_blocked(width, height, yart::Framebuffer::TILE_SIZE, [&](const yart::threads::Tile& tile) {
+            // Once cancelled, the remaining tiles are skipped and the frame winds down within one tile per thread
+            if (cancellation != nullptr && cancellation->IsCancelled())
+                return;
+
+            // Converged tiles keep their accumulated result and receive no further samples
+            uint8_t& converged = m_tileConverged[m_framebuffer.GetTileIndex(tile.x0, tile.y0)];
+            if (converged)
+                return;
+
+            // Tiles are split further into square pixel blocks traced as ray packets, also walked in Z-order
+            for (uint32_t code = 0; code < BLOCKS_PER_TILE; ++code) {
+                uint32_t block_x, block_y;
+                yart::threads::MortonDecode(code, &block_x, &block_y);
+
+                const uint32_t x = tile.x0 + block_x * PACKET_SIZE;
+                const uint32_t y = tile.y0 + block_y * PACKET_SIZE;
+                if (x >= tile.x1 || y >= tile.y1)
+                    continue;
+
+                const yart::threads::Tile block = { x, y, std::min(x + PACKET_SIZE, tile.x1), std::min(y + PACKET_SIZE, tile.y1) };
+                RenderBlock(camera, ray_directions, width, jitter, block);
+            }
+
+            if (m_renderSettings.adaptiveSampling && m_accumulatedFrames + 1 >= ADAPTIVE_MIN_FRAMES)
+                converged = EstimateTileError(tile, m_accumulatedFrames + 1) < ADAPTIVE_ERROR_THRESHOLD;
+
+            rendered_tiles.fetch_add(1, std::memory_order_relaxed);
         });
 
-        return dirty;
+        // Tiles rendered before the cancellation hold one sample more than the rest, so the partial frame has to be discarded entirely
+        if (cancellation != nullptr && cancellation->IsCancelled()) {
+            ResetAccumulation();
+            return false;
+        }
+
+        // All tiles have converged, the output buffer already holds the final image
+        if (rendered_tiles.load() == 0)
+            return dirty;
+
+        // No tile has converged yet in the first frame, so its duration is the cost of rendering the whole image at full resolution
+        if (m_accumulatedFrames == 0) {
+            m_fullFrameTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count();
+            SetHistoryView(camera);
+        }
+
+        ++m_accumulatedFrames;
+
+        // Convert to the linear layout expected by the output buffer only once the whole frame is done
+        m_framebuffer.Resolve(buffer);
+
+        return true;
     }
 
     bool Renderer::Render(yart::Camera& camera, const yart::Viewport& viewport)
     {
+        // Rendering on the calling thread, which owns the world and the settings
+        m_frameScene = m_scene->GetRenderScene();
+        m_renderWorld = *m_world;
+        m_renderSettings = m_settings;
+
         float* image_data = viewport.GetImageData();
         const ImVec2 image_size = viewport.GetImageSize();
 
         return Render(camera, image_data, image_size.x, image_size.y);
     }
 
-    void Renderer::TraceRay(yart::Camera& camera, const Ray& ray, HitPayload& payload, uint8_t bounces)
+    void Renderer::ResetAccumulation()
+    {
+        m_accumulatedFrames = 0;
+        std::fill(m_tileConverged.begin(), m_tileConverged.end(), 0);
+        m_upscaleGuidesOutdated = true;
+
+        // Start previewing with the finest block size whose pass is expected to fit in the time budget, 
+        // assuming the cost of a pass is proportional to the number of traced rays
+        uint32_t stride = 1;
+        if (m_renderSettings.progressivePreview) {
+            while (stride < PREVIEW_MAX_STRIDE && m_fullFrameTime > PREVIEW_TIME_BUDGET * static_cast<float>(stride * stride))
+                stride *= 2;
+        }
+
+        m_previewInitialStride = stride;
+        m_previewStride = stride;
+    }
+
+    bool Renderer::FinishHistoryFrame(bool rendered, float buffer[])
+    {
+        // Pixels updated before the cancellation already differ from the history, so the view has to be rendered anew
+        if (!rendered) {
+            ResetAccumulation();
+            return false;
+        }
+
+        // The frame completes the first sample of the view, which leaves no preview passes to render
+        m_framePartial = true;
+        m_previewStride = 1;
+        ++m_accumulatedFrames;
+        m_framebuffer.Resolve(buffer);
+
+        return true;
+    }
+
+    void Renderer::WriteHistoryPixel(uint32_t x, uint32_t y, const glm::vec3& color)
+    {
+        float* pixel = m_framebuffer.GetPixel(x, y);
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+        pixel[3] = 1.0f;
+
+        // The pixel holds a single sample, whose squared luminance is the second moment
+        const float luminance = Luminance(&color.r);
+        m_sampleMoments[m_framebuffer.GetPixelIndex(x, y) / yart::Framebuffer::CHANNELS] = luminance * luminance;
+    }
+
+    float Renderer::EstimateTileError(const yart::threads::Tile& tile, uint32_t samples) const
+    {
+        float max_error = 0.0f;
+        for (uint32_t y = tile.y0; y < tile.y1; ++y) {
+            for (uint32_t x = tile.x0; x < tile.x1; ++x) {
+                const float* pixel = m_framebuffer.GetPixel(x, y);
+                const float mean = Luminance(pixel);
+                const float second_moment = m_sampleMoments[m_framebuffer.GetPixelIndex(x, y) / yart::Framebuffer::CHANNELS];
+
+                // Standard error of the mean luminance, relative to the pixel brightness so that dark regions are not oversampled
+                const float variance = glm::max(0.0f, second_moment - mean * mean);
+                const float error = glm::sqrt(variance / static_cast<float>(samples)) / (mean + 0.1f);
+                max_error = glm::max(max_error, error);
+            }
+        }
+
+        return max_error;
+    }
+
+    void Renderer::RenderBlock(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, const glm::vec2& jitter, const yart::threads::Tile& block)
     {
-        // Intersect the ray with the active scene and gizmos view
+        // Gather the primary rays of the block from the camera's origin into the scene
+        yart::RayPacket packet;
+        uint32_t pixels[yart::RayPacket::SIZE];
+        for (uint32_t y = block.y0; y < block.y1; ++y) {
+            for (uint32_t x = block.x0; x < block.x1; ++x) {
+                pixels[packet.count] = y * width + x;
+                packet.rays[packet.count++] = PrimaryRay(camera.position, ray_directions, width, x, y, jitter);
+            }
+        }
+
+        HitPayload payloads[yart::RayPacket::SIZE];
+        TracePacket(camera, packet, pixels, payloads, 1);
+
+        const float weight = 1.0f / static_cast<float>(m_accumulatedFrames + 1);
+
+        uint32_t r = 0;
+        for (uint32_t y = block.y0; y < block.y1; ++y) {
+            for (uint32_t x = block.x0; x < block.x1; ++x, ++r) {
+                const HitPayload& payload = payloads[r];
+
+                // The pixel centers sampled in the first frame make up the view's history
+                if (m_accumulatedFrames == 0) {
+                    const size_t i = static_cast<size_t>(y) * width + x;
+                    m_history.Record(i, MakeHistorySample(packet.rays[r], payload, camera.GetNearClippingPlane(), camera.GetFarClippingPlane()), payload.radiance);
+                }
+
+                // Keep a running mean of all accumulated samples, along with the mean squared luminance for variance estimation
+                const size_t index = m_framebuffer.GetPixelIndex(x, y);
+                float* pixel = m_framebuffer.GetPixel(x, y);
+                pixel[0] += (payload.resultColor.r - pixel[0]) * weight;
+                pixel[1] += (payload.resultColor.g - pixel[1]) * weight;
+                pixel[2] += (payload.resultColor.b - pixel[2]) * weight;
+                pixel[3] = 1.0f;
+
+                const float luminance = Luminance(&payload.resultColor.r);
+                float& moment = m_sampleMoments[index / yart::Framebuffer::CHANNELS];
+                moment += (luminance * luminance - moment) * weight;
+            }
+        }
+    }
+
+    void Renderer::RenderPreviewTile(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t stride, const yart::threads::Tile& tile)
+    {
+        // A single packet covers PACKET_SIZE blocks of pixels in each direction
+        const uint32_t span = PACKET_SIZE * stride;
+
+        for (uint32_t y0 = tile.y0; y0 < tile.y1; y0 += span) {
+            for (uint32_t x0 = tile.x0; x0 < tile.x1; x0 += span) {
+                // Gather one primary ray through the center pixel of each block
+                yart::RayPacket packet;
+                uint32_t pixels[yart::RayPacket::SIZE];
+                yart::threads::Tile blocks[yart::RayPacket::SIZE];
+                for (uint32_t y = y0; y < std::min(y0 + span, tile.y1); y += stride) {
+                    for (uint32_t x = x0; x < std::min(x0 + span, tile.x1); x += stride) {
+                        const yart::threads::Tile block = { x, y, std::min(x + stride, tile.x1), std::min(y + stride, tile.y1) };
+                        const size_t i = static_cast<size_t>((block.y0 + block.y1) / 2) * width + (block.x0 + block.x1) / 2;
+
+                        blocks[packet.count] = block;
+                        pixels[packet.count] = static_cast<uint32_t>(i);
+                        packet.rays[packet.count++] = { camera.position, ray_directions[i], ray_directions[i + 1], ray_directions[i + width] };
+                    }
+                }
+
+                HitPayload payloads[yart::RayPacket::SIZE];
+                TracePacket(camera, packet, pixels, payloads, 1);
+
+                // Splat the results over whole blocks. Preview passes are not accumulated, they are overwritten by the first full resolution frame
+                for (uint32_t r = 0; r < packet.count; ++r) {
+                    const yart::threads::Tile& block = blocks[r];
+                    const glm::vec3& color = payloads[r].resultColor;
+
+                    for (uint32_t y = block.y0; y < block.y1; ++y) {
+                        for (uint32_t x = block.x0; x < block.x1; ++x) {
+                            float* pixel = m_framebuffer.GetPixel(x, y);
+                            pixel[0] = color.r;
+                            pixel[1] = color.g;
+                            pixel[2] = color.b;
+                            pixel[3] = 1.0f;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    bool Renderer::CanReproject(const yart::Camera& camera) const
+    {
+        // Only the view may have changed since the history was recorded, anything else might have changed the shading of the reprojected surfaces
+        return m_renderSettings.temporalReprojection && m_history.IsMovedView(camera) && IsHistoryShading();
+    }
+
+    void Renderer::SetHistoryView(const yart::Camera& camera)
+    {
+        m_history.SetView(camera, GetShadingState(), m_renderWorld);
+    }
+
+    uint32_t Renderer::GetShadingState() const
+    {
+        const RenderSettings& settings = m_renderSettings;
+        return static_cast<uint32_t>(settings.showOverlays) | static_cast<uint32_t>(settings.useThickerGrid) << 1 | static_cast<uint32_t>(settings.debugShading) << 2 
+            | static_cast<uint32_t>(settings.materialUvs) << 3 | static_cast<uint32_t>(settings.shadows) << 4;
+    }
+
+    bool Renderer::RenderReprojected(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation)
+    {
+        m_history.BeginReprojection(m_framebuffer, camera);
+
+        yart::threads::parallel_for_2d_blocked(width, height, yart::Framebuffer::TILE_SIZE, [&](const yart::threads::Tile& tile) {
+            if (cancellation != nullptr && cancellation->IsCancelled())
+                return;
+
+            for (uint32_t y = tile.y0; y < tile.y1; y += PACKET_SIZE) {
+                for (uint32_t x = tile.x0; x < tile.x1; x += PACKET_SIZE) {
+                    const yart::threads::Tile block = { x, y, std::min(x + PACKET_SIZE, tile.x1), std::min(y + PACKET_SIZE, tile.y1) };
+                    RenderReprojectedBlock(camera, ray_directions, width, block);
+                }
+            }
+        });
+
+        if (cancellation != nullptr && cancellation->IsCancelled())
+            return false;
+
+        ++m_reprojectedFrames;
+        SetHistoryView(camera);
+
+        return true;
+    }
+
+    void Renderer::RenderReprojectedBlock(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, const yart::threads::Tile& block)
+    {
+        // One pixel of each block is traced anew in every reprojected frame, so that view-dependent shading does not go stale
+        const uint32_t refreshed_pixel = m_reprojectedFrames % (PACKET_SIZE * PACKET_SIZE);
+
+        yart::RayPacket packet;
+        uint32_t traced_pixels[yart::RayPacket::SIZE];
+
+        for (uint32_t y = block.y0; y < block.y1; ++y) {
+            for (uint32_t x = block.x0; x < block.x1; ++x) {
+                const size_t i = static_cast<size_t>(y) * width + x;
+                size_t source;
+                const bool refreshed = (y % PACKET_SIZE) * PACKET_SIZE + (x % PACKET_SIZE) == refreshed_pixel;
+                if (refreshed || !m_history.FindReprojectionSource(x, y, &source)) {
+                    traced_pixels[packet.count] = static_cast<uint32_t>(i);
+                    packet.rays[packet.count++] = PrimaryRay(camera.position, ray_directions, width, x, y, glm::vec2(0.0f));
+                    continue;
+                }
+
+                // Reuse the color and hit of the previous view's pixel
+                WriteHistoryPixel(x, y, m_history.Reproject(i, source));
+            }
+        }
+
+        if (packet.count == 0)
+            return;
+
+        HitPayload payloads[yart::RayPacket::SIZE];
+        TracePacket(camera, packet, traced_pixels, payloads, 1);
+
+        for (uint32_t r = 0; r < packet.count; ++r) {
+            const HitPayload& payload = payloads[r];
+            const uint32_t x = traced_pixels[r] % width;
+            const uint32_t y = traced_pixels[r] / width;
+
+            WriteHistoryPixel(x, y, payload.resultColor);
+            m_history.Record(traced_pixels[r], MakeHistorySample(packet.rays[r], payload, camera.GetNearClippingPlane(), camera.GetFarClippingPlane()), payload.radiance);
+        }
+    }
+
+    bool Renderer::GatherObjectEdits(const yart::RenderScene& previous_scene)
+    {
+        std::vector<yart::RenderObjectChange> changes;
+        if (!m_renderScene->FindChangedObjects(previous_scene, changes))
+            return false;
+
+        m_objectEdits.clear();
+        m_editsChangeGeometry = false;
+        for (const yart::RenderObjectChange& change : changes) {
+            m_objectEdits.push_back({ 
+                static_cast<uint32_t>(change.index), change.geometryChanged, 
+                previous_scene.GetObjectBounds(change.index), m_renderScene->GetObjectBounds(change.index)
+            });
+
+            m_editsChangeGeometry |= change.geometryChanged;
+        }
+
+        return true;
+    }
+
+    bool Renderer::RenderSparse(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation)
+    {
+        // Retraced pixels overwrite the history, which is incomplete until the frame is done
+        m_history.Invalidate();
+
+        if (!m_objectEdits.empty()) {
+            yart::threads::parallel_for_2d_blocked(width, height, yart::Framebuffer::TILE_SIZE, [&](const yart::threads::Tile& tile) {
+                if (cancellation != nullptr && cancellation->IsCancelled())
+                    return;
+
+                for (uint32_t y = tile.y0; y < tile.y1; y += PACKET_SIZE) {
+                    for (uint32_t x = tile.x0; x < tile.x1; x += PACKET_SIZE) {
+                        const yart::threads::Tile block = { x, y, std::min(x + PACKET_SIZE, tile.x1), std::min(y + PACKET_SIZE, tile.y1) };
+                        RenderSparseBlock(camera, ray_directions, width, block);
+                    }
+                }
+            });
+
+            if (cancellation != nullptr && cancellation->IsCancelled())
+                return false;
+        }
+
+        SetHistoryView(camera);
+        return true;
+    }
+
+    void Renderer::RenderSparseBlock(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, const yart::threads::Tile& block)
+    {
+        const float far = camera.GetFarClippingPlane();
+
+        yart::RayPacket packet;
+        uint32_t traced_pixels[yart::RayPacket::SIZE];
+
+        for (uint32_t y = block.y0; y < block.y1; ++y) {
+            for (uint32_t x = block.x0; x < block.x1; ++x) {
+                const size_t i = static_cast<size_t>(y) * width + x;
+                if (!IsAffectedByEdits(camera.position, ray_directions[i], far, m_history.GetSample(i)))
+                    continue;
+
+                // Material edits leave the primary hits in place
+                if (!m_editsChangeGeometry) {
+                    ReshadePixel(camera, ray_directions, width, x, y);
+                    continue;
+                }
+
+                traced_pixels[packet.count] = static_cast<uint32_t>(i);
+                packet.rays[packet.count++] = PrimaryRay(camera.position, ray_directions, width, x, y, glm::vec2(0.0f));
+            }
+        }
+
+        if (packet.count == 0)
+            return;
+
+        HitPayload payloads[yart::RayPacket::SIZE];
+        TracePacket(camera, packet, traced_pixels, payloads, 1);
+
+        for (uint32_t r = 0; r < packet.count; ++r) {
+            const HitPayload& payload = payloads[r];
+            const uint32_t x = traced_pixels[r] % width;
+            const uint32_t y = traced_pixels[r] / width;
+
+            WriteHistoryPixel(x, y, payload.resultColor);
+            m_history.Record(traced_pixels[r], MakeHistorySample(packet.rays[r], payload, camera.GetNearClippingPlane(), far), payload.radiance);
+        }
+    }
+
+    bool Renderer::IsAffectedByEdits(const glm::vec3& origin, const glm::vec3& direction, float far, const yart::HistorySample& sample) const
+    {
+        const bool hit = sample.hit.w != 0.0f;
+        const glm::vec3 hit_position = glm::vec3(sample.hit);
+
+        for (const ObjectEdit& edit : m_objectEdits) {
+            // The object has been seen directly or in a reflection
+            if (sample.object == edit.index || sample.reflectedObject == edit.index)
+                return true;
+
+            if (!edit.geometryChanged)
+                continue;
+
+            // Reflection rays are not recorded, any of them might reach the object's new extent
+            if (sample.reflected)
+                return true;
+
+            // The object might have moved in front of the primary hit
+            const float primary_length = hit ? glm::distance(origin, hit_position) : far;
+            if (SegmentIntersectsBounds(origin, direction, primary_length, edit.bounds))
+                return true;
+
+            // The object might have stopped or started shadowing the primary hit
+            if (hit && m_renderSettings.shadows) {
+                for (size_t l = 0; l < yart::World::LIGHT_COUNT; ++l) {
+                    const glm::vec3& light_position = m_renderWorld.lights[l].position;
+                    const float light_distance = glm::distance(hit_position, light_position);
+                    const glm::vec3 light_direction = (light_position - hit_position) / light_distance;
+
+                    if (SegmentIntersectsBounds(hit_position, light_direction, light_distance, edit.previousBounds) 
+                        || SegmentIntersectsBounds(hit_position, light_direction, light_distance, edit.bounds))
+                        return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    yart::HistorySample Renderer::MakeHistorySample(const yart::Ray& ray, const HitPayload& payload, float near, float far) const
+    {
+        if (payload.hitDistance < near || payload.hitDistance > far || payload.hitObject == nullptr)
+            return { glm::vec4(0.0f), glm::vec3(0.0f), glm::vec2(0.0f), yart::RenderHistory::NO_OBJECT, yart::RenderHistory::NO_OBJECT, false };
+
+        // Hit objects are stored in the snapshot's contiguous object array
+        size_t object_count;
+        const yart::RenderObject* objects = m_renderScene->GetObjects(&object_count);
+
+        return { 
+            glm::vec4(ray.origin + ray.direction * payload.hitDistance, 1.0f), payload.hitNormal, payload.hitBarycentrics, 
+            static_cast<uint32_t>(payload.hitObject - objects),
+            payload.reflectedObject != nullptr ? static_cast<uint32_t>(payload.reflectedObject - objects) : yart::RenderHistory::NO_OBJECT, payload.reflected
+        };
+    }
+
+    bool Renderer::RenderReshaded(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation)
+    {
+        YART_ASSERT(m_history.IsView(camera));
+
+        // Reshaded pixels refresh the recorded reflections, which are incomplete until the frame is done
+        m_history.Invalidate();
+
+        yart::threads::parallel_for_2d_blocked(width, height, yart::Framebuffer::TILE_SIZE, [&](const yart::threads::Tile& tile) {
+            if (cancellation != nullptr && cancellation->IsCancelled())
+                return;
+
+            for (uint32_t y = tile.y0; y < tile.y1; ++y) {
+                for (uint32_t x = tile.x0; x < tile.x1; ++x)
+                    ReshadePixel(camera, ray_directions, width, x, y);
+            }
+        });
+
+        if (cancellation != nullptr && cancellation->IsCancelled())
+            return false;
+
+        SetHistoryView(camera);
+        return true;
+    }
+
+    void Renderer::ReshadePixel(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t x, uint32_t y)
+    {
+        const size_t i = static_cast<size_t>(y) * width + x;
+        yart::HistorySample& sample = m_history.GetSample(i);
+        yart::Ray ray = PrimaryRay(camera.position, ray_directions, width, x, y, glm::vec2(0.0f));
+
+        size_t object_count;
+        const yart::RenderObject* objects = m_renderScene->GetObjects(&object_count);
+
+        HitPayload payload;
+        payload.hitObject = nullptr;
+        payload.hitDistance = -1.0f;
+        payload.reflectedObject = nullptr;
+        payload.reflected = false;
+
+        if (sample.object != yart::RenderHistory::NO_OBJECT) {
+            YART_ASSERT(sample.object < object_count);
+
+            // Reprojected hits do not lie on their pixel's center ray, so the ray is aimed at the recorded hit instead
+            const glm::vec3 to_hit = glm::vec3(sample.hit) - ray.origin;
+            payload.hitDistance = glm::length(to_hit);
+            payload.hitObject = &objects[sample.object];
+            payload.hitNormal = sample.normal;
+            ray.direction = to_hit / payload.hitDistance;
+        }
+
+        TraceRay(camera, ray, GetSurfaceAttributes(payload.hitObject, sample.normal, sample.barycentrics), i, payload, 1);
+
+        WriteHistoryPixel(x, y, payload.resultColor);
+        m_history.Record(i, payload.radiance);
+
+        // Reflections are not traced with debug shading, so they might have changed along with the shading options
+        if (sample.object != yart::RenderHistory::NO_OBJECT) {
+            sample.reflected = payload.reflected;
+            sample.reflectedObject = payload.reflectedObject != nullptr ? static_cast<uint32_t>(payload.reflectedObject - objects) : yart::RenderHistory::NO_OBJECT;
+        }
+    }
+
+    bool Renderer::IsHistoryShading() const
+    {
+        return m_history.IsShading(GetShadingState(), m_renderWorld);
+    }
+
+    bool Renderer::RenderRecomposited(uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation)
+    {
+        const glm::vec3 ambient = AMBIENT_STRENGTH * m_renderWorld.ambientColor;
+
+        yart::threads::parallel_for_2d_blocked(width, height, yart::Framebuffer::TILE_SIZE, [&](const yart::threads::Tile& tile) {
+            if (cancellation != nullptr && cancellation->IsCancelled())
+                return;
+
+            for (uint32_t y = tile.y0; y < tile.y1; ++y) {
+                for (uint32_t x = tile.x0; x < tile.x1; ++x) {
+                    const yart::RadianceSample& radiance = m_history.GetRadiance(static_cast<size_t>(y) * width + x);
+
+                    glm::vec3 color = radiance.constant + radiance.ambientWeight * ambient;
+                    for (size_t i = 0; i < yart::World::LIGHT_COUNT; ++i)
+                        color += m_renderWorld.lights[i].intensity * (radiance.diffuse[i] + radiance.specular[i]);
+
+                    if (radiance.skyWeight > 0.0f)
+                        color += radiance.skyWeight * m_renderWorld.SampleSkyColor(radiance.skyDirection);
+
+                    WriteHistoryPixel(x, y, color);
+                }
+            }
+        });
+
+        return cancellation == nullptr || !cancellation->IsCancelled();
+    }
+
+    glm::vec3 Renderer::GetSurfaceAttributes(const yart::RenderObject* object, const glm::vec3& normal, const glm::vec2& barycentrics) const
+    {
+        // Only mesh hits have uvs, SDF hits return their normal either way
+        if (m_renderSettings.debugShading && m_renderSettings.materialUvs && object != nullptr && object->type == yart::ObjectType::MESH)
+            return glm::vec3(barycentrics, 0.0f);
+
+        return normal;
+    }
+
+    void Renderer::TracePacket(yart::Camera& camera, const yart::RayPacket& packet, const uint32_t pixels[], HitPayload payloads[], uint8_t bounces)
+    {
+        // Intersect all primary rays with the active scene at once
+        // Normals and barycentrics are both kept for the history, the surface attributes are picked from them afterwards
+        const yart::RenderObject* hit_objects[yart::RayPacket::SIZE];
+        glm::vec3 normals[yart::RayPacket::SIZE];
+        glm::vec2 barycentrics[yart::RayPacket::SIZE];
+        float hit_distances[yart::RayPacket::SIZE];
+        m_renderScene->IntersectPacket(packet, hit_objects, false, normals, hit_distances, camera.GetFarClippingPlane(), barycentrics);
+
+        for (uint32_t i = 0; i < packet.count; ++i) {
+            payloads[i].hitObject = hit_objects[i];
+            payloads[i].hitDistance = hit_distances[i];
+            payloads[i].hitNormal = normals[i];
+            payloads[i].hitBarycentrics = hit_objects[i] != nullptr ? barycentrics[i] : glm::vec2(0.0f);
+            payloads[i].reflectedObject = nullptr;
+            payloads[i].reflected = false;
+            TraceRay(camera, packet.rays[i], GetSurfaceAttributes(hit_objects[i], normals[i], payloads[i].hitBarycentrics), pixels[i], payloads[i], bounces);
+        }
+    }
+
+    void Renderer::TraceRay(yart::Camera& camera, const Ray& ray, const glm::vec3& surface, size_t pixel, HitPayload& payload, uint8_t bounces)
+    {
+        // Look up the gizmos view of the pixel, sampled through its center
         glm::vec4 overlay_color = { 0.0f, 0.0f, 0.0f, 0.0f };
-        float overlay_distance = m_showOverlays ? SampleOverlaysView(ray, overlay_color) : std::numeric_limits<float>::max();
+        float overlay_distance = std::numeric_limits<float>::max();
+        if (m_renderSettings.showOverlays) {
+            overlay_color = m_overlayLayer[pixel].color;
+            overlay_distance = m_overlayLayer[pixel].distance;
+        }
 
-        if (TraceRaySingle(camera.GetNearClippingPlane(), camera.GetFarClippingPlane(), ray, payload)) {
+        if (ShadeHit(camera.GetNearClippingPlane(), camera.GetFarClippingPlane(), ray, surface, payload)) {
             // Handle reflections
             glm::vec3 ray_dir = ray.direction;
             HitPayload reflection_payload = payload;
@@ -78,10 +950,17 @@ namespace yart
                 
                 ray_dir = glm::reflect(ray_dir, reflection_payload.hitNormal);
                 const yart::Ray reflection_ray = { reflection_payload.hitPosition, ray_dir };
-                if (!TraceRaySingle(0.0f, camera.GetFarClippingPlane(), reflection_ray, reflection_payload))
+                const bool reflection_hit = TraceRaySingle(0.0f, camera.GetFarClippingPlane(), reflection_ray, reflection_payload);
+                if (i == 0) {
+                    payload.reflected = true;
+                    payload.reflectedObject = reflection_hit ? reflection_payload.hitObject : nullptr;
+                }
+
+                if (!reflection_hit)
                     i = bounces;
 
                 payload.resultColor = payload.resultColor * (1.0f - reflection_strength) + reflection_payload.resultColor * reflection_strength;
+                payload.radiance.Blend(reflection_payload.radiance, reflection_strength);
             }
         }
 
@@ -90,6 +969,7 @@ namespace yart
         }
 
         payload.resultColor = payload.resultColor * (1.0f - overlay_color.a) + glm::vec3(overlay_color) * overlay_color.a;
+        payload.radiance.Blend(glm::vec3(overlay_color), overlay_color.a);
 
     }
 
@@ -97,62 +977,95 @@ namespace yart
     {
         // Intersect the ray with the active scene
         glm::vec3 out_vec;
-        float hit_distance = m_scene->IntersectRay(ray, &payload.hitObject, m_debugShading && m_materialUvs, out_vec);
-        payload.hitDistance = hit_distance;
+        payload.hitDistance = m_renderScene->IntersectRay(ray, &payload.hitObject, m_renderSettings.debugShading && m_renderSettings.materialUvs, out_vec, far);
 
+        return ShadeHit(near, far, ray, out_vec, payload);
+    }
+
+    bool Renderer::ShadeHit(float near, float far, const yart::Ray& ray, const glm::vec3& surface, HitPayload& payload)
+    {
+        const float hit_distance = payload.hitDistance;
         if (hit_distance < near || hit_distance > far) {
             Miss(ray, payload);
             return false;
         }
 
-        if (m_debugShading) {
-            payload.resultColor = out_vec;
+        payload.radiance = { };
+        if (m_renderSettings.debugShading) {
+            payload.resultColor = surface;
+            payload.radiance.constant = surface;
             return false;
         } 
 
         payload.hitPosition = ray.origin + ray.direction * hit_distance;
-        payload.hitNormal = out_vec;
-
-        static constexpr size_t num_lights = 3;
-        static constexpr glm::vec3 light_positions[num_lights] = { { -2.0f, 4.0f, -3.0f }, { 2.0f, 1.0f, -2.0f }, { -0.5f, 0.5f, -4.0f } };
-        static constexpr float light_intensities[num_lights] = { 0.8f, 0.5f, 0.2f };
+        payload.hitNormal = surface;
 
         float diffuse = 0.0f;
         float specular = 0.0f;
-        for (size_t i = 0; i < num_lights; ++i) {
-            const float dist = glm::distance(payload.hitPosition, light_positions[i]);
-            const glm::vec3 dir = glm::normalize(light_positions[i] - payload.hitPosition);
+        for (size_t i = 0; i < yart::World::LIGHT_COUNT; ++i) {
+            const yart::PointLight& light = m_renderWorld.lights[i];
+            const float dist = glm::distance(payload.hitPosition, light.position);
+            const glm::vec3 dir = glm::normalize(light.position - payload.hitPosition);
             
             float shadow = 1.0f;
-            if (m_shadows && glm::dot(dir, payload.hitNormal) > 0) {
+            if (m_renderSettings.shadows && glm::dot(dir, payload.hitNormal) > 0) {
                 const yart::Ray shadow_ray = { payload.hitPosition, dir, dir, dir };
 
+                // Only occluders between the surface and the light source matter. The shadow falloff depends on the distance to the closest one, 
+                // so the query cannot end on the first occluder found, but hits beyond the light are still culled
                 glm::vec3 _ignored;
-                yart::Object* shadow_hit_object;
-                const float shadow_hit_distance = m_scene->IntersectRay(shadow_ray, &shadow_hit_object, false, _ignored);
+                const yart::RenderObject* shadow_hit_object;
+                const float shadow_hit_distance = m_renderScene->IntersectRay(shadow_ray, &shadow_hit_object, false, _ignored, dist);
 
-                if (shadow_hit_distance > 0.0f && shadow_hit_distance < dist)
+                if (shadow_hit_distance > 0.0f)
                     shadow = 1.0f + 1.0f / (-4.0f * shadow_hit_distance - 1.0f);
             }
 
             
             const glm::vec3 h = glm::normalize(dir - ray.direction); // Half vector for specular
-            const float intensity = light_intensities[i] * 1.0f / (0.01f * dist * dist + 1.0f); // Inverse-square falloff 
+            const float falloff = 1.0f / (0.01f * dist * dist + 1.0f); // Inverse-square falloff 
 
             const float ld = glm::max(0.0f, glm::dot(payload.hitNormal, dir));
             const float ls = glm::pow(glm::max(0.0f, glm::dot(payload.hitNormal, h)), payload.hitObject->materialSpecularFalloff);
 
-            diffuse += shadow * payload.hitObject->materialDiffuse * intensity * ld;
-            specular += shadow * payload.hitObject->materialSpecular * intensity * payload.hitObject->materialSpecularFalloff / 256.0f * ls;
+            // Light contributions at unit intensity are kept in the radiance decomposition
+            const float light_diffuse = shadow * payload.hitObject->materialDiffuse * falloff * ld;
+            const float light_specular = shadow * payload.hitObject->materialSpecular * falloff * payload.hitObject->materialSpecularFalloff / 256.0f * ls;
+            payload.radiance.diffuse[i] = payload.hitObject->materialColor * light_diffuse;
+            payload.radiance.specular[i] = light_specular;
+
+            diffuse += light.intensity * light_diffuse;
+            specular += light.intensity * light_specular;
         }
 
-        const glm::vec3 ambient = 0.03f * m_world->ambientColor;
+        const glm::vec3 ambient = AMBIENT_STRENGTH * m_renderWorld.ambientColor;
         const glm::vec3 mat_col = ambient + payload.hitObject->materialColor * diffuse + specular;
+        payload.radiance.ambientWeight = 1.0f;
 
         payload.resultColor = mat_col;
         return true;
     }
 
+    void Renderer::UpdateOverlayLayer(const yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height)
+    {
+        yart::threads::parallel_for_2d_blocked(width, height, yart::Framebuffer::TILE_SIZE, [&](const yart::threads::Tile& tile) {
+            for (uint32_t y = tile.y0; y < tile.y1; ++y) {
+                for (uint32_t x = tile.x0; x < tile.x1; ++x) {
+                    OverlaySample& overlay = m_overlayLayer[static_cast<size_t>(y) * width + x];
+                    overlay.color = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    overlay.distance = SampleOverlaysView(PrimaryRay(camera.position, ray_directions, width, x, y, glm::vec2(0.0f)), overlay.color);
+                }
+            }
+        });
+
+        m_overlayLayerValid = true;
+        m_overlayCameraPosition = camera.position;
+        m_overlayCameraDirection = camera.GetLookDirection();
+        m_overlayCameraFOV = camera.GetFOV();
+        m_overlayNearClippingPlane = camera.GetNearClippingPlane();
+        m_overlayThickerGrid = m_renderSettings.useThickerGrid;
+    }
+
     float Renderer::SampleOverlaysView(const yart::Ray &ray, glm::vec4 &color)
     {
         // Grid plane
@@ -174,7 +1087,7 @@ namespace yart
             const glm::vec2 w = glm::max(glm::abs(uv_ddx), glm::abs(uv_ddy)) + glm::max(grid_plane_distance / 400.0f, 0.0001f);
 
             // Analytic (box) filtering
-            const float N = m_useThickerGrid ? 50.0f : 100.0f;
+            const float N = m_renderSettings.useThickerGrid ? 50.0f : 100.0f;
             const glm::vec2 a = uv + 0.5f * w;                        
             const glm::vec2 b = uv - 0.5f * w;           
             const glm::vec2 i = (glm::floor(a) + glm::min(glm::fract(a) * N, 1.0f) - glm::floor(b) - glm::min(glm::fract(b) * N, 1.0f)) / (N * w);
@@ -193,6 +1106,10 @@ namespace yart
 
     void Renderer::Miss(const Ray& ray, HitPayload& payload)
     {
-        payload.resultColor = m_world->SampleSkyColor(ray.direction);
+        payload.resultColor = m_renderWorld.SampleSkyColor(ray.direction);
+
+        payload.radiance = { };
+        payload.radiance.skyDirection = ray.direction;
+        payload.radiance.skyWeight = 1.0f;
     }
 } // namespace yart
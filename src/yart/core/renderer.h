@@ -6,13 +6,23 @@
 #pragma once
 
 
+#include <condition_variable>
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <thread>
+#include <mutex>
 
 #include <glm/glm.hpp>
 
 #include "yart/interface/views/renderer_view.h"
+#include "yart/common/threads/cancellation_token.h"
+#include "yart/common/threads/tile_scheduler.h"
+#include "yart/common/threads/triple_buffer.h"
+#include "yart/core/framebuffer.h"
+#include "yart/core/render_history.h"
+#include "yart/core/render_scene.h"
+#include "yart/core/upscaler.h"
 #include "yart/core/viewport.h"
 #include "yart/core/camera.h"
 #include "yart/core/scene.h"
@@ -27,29 +37,102 @@ namespace yart
     ////////////////////////////////////////////////////////////////////////////////////////////////////
     class Renderer {
     public:
+        Renderer() = default;
+
+        /// @brief Renderer class destructor, stopping the render thread if it is running
+        ~Renderer();
+
+        /// @brief Request a new frame to be rendered asynchronously on the dedicated render thread
+        /// @details The render thread is started on the first call. Requests made while a frame is still being rendered 
+        ///     are coalesced, so that only the latest view gets rendered next, and the frame in flight is cancelled if the request makes it obsolete. 
+        ///     The frame renders the scene snapshot published at the time of the request, so scene edits should be published beforehand. 
+        ///     Rendered frames can be retrieved with Renderer::PresentFrame()
+        /// @param camera YART camera instance, from which perspective to render. Its viewing parameters are copied, 
+        ///     so the camera can be modified freely after this call
+        /// @param width Width in pixels of the rendered image
+        /// @param height Height in pixels of the rendered image
+        /// @param output_width Width in pixels of the output image. Renders smaller than the output are upscaled with yart::Upscaler
+        /// @param output_height Height in pixels of the output image
+        /// @param reset Whether the accumulated samples should be discarded before rendering the frame, e.g. after the camera or the scene changed 
+        void RequestFrame(const yart::Camera& camera, uint32_t width, uint32_t height, uint32_t output_width, uint32_t output_height, bool reset);
+
+        /// @brief Copy the latest frame completed by the render thread into a viewport's image data
+        /// @details Never waits for the render thread. Frames rendered for a different size than the current viewport image size are dropped
+        /// @param viewport Viewport to present the frame in
+        /// @return Whether a new frame has been presented, and the viewport image should be refreshed
+        bool PresentFrame(yart::Viewport& viewport);
+
+        /// @brief Stop and join the render thread, waiting for the frame currently being rendered to finish
+        /// @note Should be called before shutting down the application, while the scene and the global thread pool are still alive
+        void StopRenderThread();
+
         /// @brief Render the active scene to a given buffer
         /// @param camera YART camera instance, from which perspective to render
         /// @param buffer Pointer to a pixel array to be rendered onto. 
         ///     The size of the array should be equal to width*height*4, where 4 denotes the number of channels in the output image (RGBA)
         /// @param width Width in pixels of the output image
         /// @param height Height in pixels of the output image
+        /// @param cancellation Optional token checked once per image tile. A cancelled frame is abandoned without writing 
+        ///     to the output buffer, and all accumulated samples are discarded
+        /// @details Frames of an unchanged view and scene accumulate jittered samples, until Renderer::MAX_ACCUMULATED_FRAMES samples per pixel 
+        ///     are reached or, with adaptive sampling enabled, until the image tiles converge. 
+        ///     The first frame after a reset takes the first path allowed by the enabled render settings:
+        ///      - sparse updates retrace only the pixels which the edited objects might have touched,
+        ///      - lighting recomposition recomposites the recorded radiance after lighting parameter changes,
+        ///      - deferred shading reshades the recorded primary hits when neither the view nor the scene geometry has changed,
+        ///      - temporal reprojection reprojects the previous image after view changes,
+        ///      - progressive preview renders coarse previews ahead of the first fully traced frame
         /// @return Whether the current frame has changed visually from the previous rendered frame (used for conditional viewport refreshing) 
-        bool Render(yart::Camera& camera, float buffer[], uint32_t width, uint32_t height);
+        bool Render(yart::Camera& camera, float buffer[], uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation = nullptr);
 
-        /// @brief Render the active scene directly to a given viewport
+        /// @brief Render the active scene directly to a given viewport, with the latest published scene snapshot and the current render settings and world
+        /// @note Should not be called while the render thread is running
         /// @param camera YART camera instance, from which perspective to render
         /// @param viewport Viewport to render to
         /// @return Whether the current frame has changed visually from the previous rendered frame (used for conditional viewport refreshing) 
         bool Render(yart::Camera& camera, const yart::Viewport& viewport);
 
+        /// @brief Discard all accumulated samples, restarting progressive rendering from the next frame
+        /// @note Should be called whenever the camera, the scene or any render setting changes. 
+        ///     Newly published scene snapshots and output size changes reset the accumulation automatically.
+        ///     While the render thread is running, the `reset` parameter of Renderer::RequestFrame() should be used instead
+        void ResetAccumulation();
+
+        /// @brief Get the number of samples per pixel accumulated in the latest presented frame
+        /// @return Accumulated frame count
+        uint32_t GetAccumulatedFrames() const
+        {
+            return m_presentedFrameSamples;
+        }
+
+        /// @brief Get the time it took the render thread to render the latest presented frame
+        /// @details Upscaling the frame to the output resolution is not included, as its cost does not depend on the rendered image size
+        /// @return Render time in seconds
+        float GetPresentedFrameTime() const
+        {
+            return m_presentedFrameTime;
+        }
+
+        /// @brief Check whether the latest presented frame has traced only some of its pixels, reusing the rest from the previous image
+        /// @details Frames reprojected from the previous view, sparse updates after object edits and frames reshading or recompositing 
+        ///     the recorded primary hits are partial
+        /// @return Whether the presented frame is partial
+        bool IsPresentedFramePartial() const
+        {
+            return m_presentedFramePartial;
+        }
+
         /// @brief Set a scene to be used for rendering by this renderer
         /// @param scene New scene instance
+        /// @note Should not be called while the render thread is running
         void SetScene(std::shared_ptr<yart::Scene> scene) 
         {
             m_scene = scene;
+            ResetAccumulation();
         }
 
         /// @brief Get the renderer's world instance 
+        /// @details The world is copied into each frame request, so it can be modified freely while the render thread is running
         /// @return Renderer's world instance pointer
         yart::World* GetWorld() const 
         {
@@ -57,23 +140,232 @@ namespace yart
         }
 
     private:
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Completed frame, exchanged between the render thread and the UI thread
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct FrameImage {
+            std::vector<float> data; ///< Linear RGBA pixel array of the frame
+            uint32_t width = 0; ///< Width in pixels of the frame
+            uint32_t height = 0; ///< Height in pixels of the frame
+            uint32_t samples = 0; ///< Number of samples per pixel accumulated in the frame
+            float renderTime = 0.0f; ///< Time in seconds spent rendering the frame at the rendered resolution, excluding its upscaling
+            bool partial = false; ///< Whether only some of the frame's pixels have been traced, the rest being reused from the previous image
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Render settings exposed in the renderer view
+        /// @details Edited by the UI thread and copied into each frame request, so that the render thread reads only its own copy
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct RenderSettings {
+            bool showOverlays = true; ///< Whether the overlays layer should be rendered
+            bool useThickerGrid = false; ///< Whether the overlay grid should use a thicker outline
+            bool debugShading = false; ///< Whether to render the surface uvs or normals as the object's material 
+            bool materialUvs = false; ///< Whether to render the surface uvs as the object's material when `debugShading` is true
+            bool shadows = true; ///< Whether to cast and render surface shadows
+            bool adaptiveSampling = true; ///< Whether converged image tiles should stop receiving samples
+            bool progressivePreview = true; ///< Whether coarse preview frames should be rendered after each reset, e.g. during camera motion
+            bool temporalReprojection = true; ///< Whether the first frame after a view change should be reprojected from the previous one
+            bool sparseUpdates = true; ///< Whether object edits should retrace only the pixels affected by the changed objects
+            bool deferredShading = true; ///< Whether resets keeping the view and the scene geometry should reshade the recorded primary hits instead of tracing them
+            bool lightingRecomposition = true; ///< Whether resets changing only the lighting parameters should recomposite the recorded radiance decompositions
+        };
+
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         /// @brief Structure holding data returned as a result of tracing a ray into the scene 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         struct HitPayload {
             float hitDistance; ///< Distance from the ray origin to a registered hit surface, or a negative value on ray miss
-            yart::Object* hitObject; ///< Object hit by the ray
+            const yart::RenderObject* hitObject; ///< Object hit by the ray
             glm::vec3 hitNormal; ///< Normal vector of the hit surface
             glm::vec3 hitPosition; ///< Hit position vector in world-space
             glm::vec3 resultColor; ///< Color of the hit surface
+            glm::vec2 hitBarycentrics; ///< Barycentric coordinates of the primary hit triangle, or zero for SDF hits
+            const yart::RenderObject* reflectedObject; ///< Object hit by the first reflection bounce, or nullptr
+            bool reflected; ///< Whether a reflection ray has been traced from the hit surface
+            yart::RadianceSample radiance; ///< Decomposition of `resultColor` into the lighting terms
         };
 
-        /// @brief Trace a ray with a specified number of max bounces and store the results in a HitPayload structure
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Overlays/gizmos layer sample of a single pixel, cached in between frames of the same view
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct OverlaySample {
+            glm::vec4 color; ///< Color of the overlays seen through the pixel center, or a transparent color on miss
+            float distance; ///< Distance from the camera to the closest overlay along the pixel's center ray, or a negative value on miss
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Object changed in between the history and the current scene snapshot
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct ObjectEdit {
+            uint32_t index; ///< Index of the changed object, the same in both scene snapshots
+            bool geometryChanged; ///< Whether the object's geometry has changed, rather than just its material
+            yart::AABB previousBounds; ///< World-space bounds of the object in the history snapshot
+            yart::AABB bounds; ///< World-space bounds of the object in the current snapshot
+        };
+
+        /// @brief Main loop of the render thread, rendering requested frames into the back buffer
+        void RenderThreadMain();
+
+        /// @brief Render a block of pixels, small enough to be traced as a single ray packet, and accumulate it into the framebuffer
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param jitter Subpixel offset of the primary rays in the `[-0.5, 0.5)` range, shared by all pixels in the frame
+        /// @param block Rendered pixel block
+        void RenderBlock(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, const glm::vec2& jitter, const yart::threads::Tile& block);
+
+        /// @brief Render a coarse preview of an image tile into the framebuffer, tracing a single ray per square block of pixels
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param stride Width and height in pixels of the blocks
+        /// @param tile Rendered image tile
+        void RenderPreviewTile(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t stride, const yart::threads::Tile& tile);
+
+        /// @brief Check whether the first frame of a view can be reprojected from the recorded history
+        /// @param camera YART camera instance of the new view
+        /// @return Whether the history is complete, and only the view has changed since it has been recorded
+        bool CanReproject(const yart::Camera& camera) const;
+
+        /// @brief Mark the history as complete for a given view, rendered with the current shading settings and light positions
+        /// @param camera YART camera instance of the view, whose primary hits have been recorded
+        void SetHistoryView(const yart::Camera& camera);
+
+        /// @brief Get the render settings affecting the shading of surfaces, which invalidate the reprojection history when changed
+        /// @return Bit mask of the settings
+        uint32_t GetShadingState() const;
+
+        /// @brief Check whether the history has been shaded with the current render settings and light positions
+        /// @return Whether the recorded colors and radiance decompositions are up to date, apart from the lighting parameters
+        bool IsHistoryShading() const;
+
+        /// @brief Render the first frame of an unchanged view, scene and light positions, recompositing the recorded radiance decompositions
+        /// @details Lighting parameters are read from the render thread's copy of the world, taken over with the frame request
+        /// @param width Width in pixels of the output image
+        /// @param height Height in pixels of the output image
+        /// @param cancellation Optional token checked once per image tile
+        /// @return Whether the frame has been rendered, or `false` if it has been cancelled
+        bool RenderRecomposited(uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation);
+
+        /// @brief Render the first frame of a new view, reprojecting the previous image and tracing only the pixels it could not fill
+        /// @details The primary hits of the previous view are scattered into the new view with a depth test. Pixels with no reprojected hit, 
+        ///     pixels whose reprojected hit might be occluded, and a rolling fraction of all pixels are traced anew
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param height Height in pixels of the output image
+        /// @param cancellation Optional token checked once per image tile
+        /// @return Whether the frame has been rendered, or `false` if it has been cancelled
+        bool RenderReprojected(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation);
+
+        /// @brief Fill a block of pixels from the reprojected previous image, tracing the pixels which could not be reprojected as a single ray packet
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param block Rendered pixel block
+        void RenderReprojectedBlock(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, const yart::threads::Tile& block);
+
+        /// @brief Gather the objects changed since the scene snapshot the history has been rendered with into `m_objectEdits`
+        /// @param previous_scene Scene snapshot the history has been rendered with
+        /// @return Whether the objects of both snapshots could be matched
+        bool GatherObjectEdits(const yart::RenderScene& previous_scene);
+
+        /// @brief Render the first frame of a new scene snapshot, updating only the pixels whose rays might have touched the changed objects
+        /// @details Pixels are retraced if any object's geometry has changed, or just reshaded from the history otherwise
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param height Height in pixels of the output image
+        /// @param cancellation Optional token checked once per image tile
+        /// @return Whether the frame has been rendered, or `false` if it has been cancelled
+        bool RenderSparse(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation);
+
+        /// @brief Update the pixels of a block affected by the changed objects, retracing them as a single ray packet if needed
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param block Rendered pixel block
+        void RenderSparseBlock(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, const yart::threads::Tile& block);
+
+        /// @brief Check whether any ray recorded for a pixel might have touched one of the changed objects
+        /// @details Pixels are affected when their primary or reflection ray has hit a changed object. For objects whose geometry has changed, 
+        ///     pixels are also affected when their primary ray segment crosses the object's new bounds, when any of their shadow ray segments 
+        ///     crosses its old or new bounds, or when their primary surface is reflective, since reflection rays only record the object they have hit
+        /// @param origin Camera position
+        /// @param direction Direction of the pixel's center ray
+        /// @param far Far clipping plane distance
+        /// @param sample History sample of the pixel
+        /// @return Whether the pixel should be retraced
+        bool IsAffectedByEdits(const glm::vec3& origin, const glm::vec3& direction, float far, const yart::HistorySample& sample) const;
+
+        /// @brief Build the history sample of a primary ray traced through a pixel center
+        /// @param ray Primary ray
+        /// @param payload HitPayload structure holding the tracing results of the ray
+        /// @param near Near clipping plane distance
+        /// @param far Far clipping plane distance
+        /// @return History sample of the pixel
+        yart::HistorySample MakeHistorySample(const yart::Ray& ray, const HitPayload& payload, float near, float far) const;
+
+        /// @brief Render the first frame of an unchanged view and scene geometry, reshading the recorded primary hits without tracing them
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param height Height in pixels of the output image
+        /// @param cancellation Optional token checked once per image tile
+        /// @return Whether the frame has been rendered, or `false` if it has been cancelled
+        bool RenderReshaded(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height, const yart::threads::CancellationToken* cancellation);
+
+        /// @brief Reshade the recorded primary hit of a single pixel into the framebuffer, and refresh its recorded reflection
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param x Horizontal pixel coordinate
+        /// @param y Vertical pixel coordinate
+        void ReshadePixel(yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t x, uint32_t y);
+
+        /// @brief Get the surface attributes passed to the shading of a primary hit, as they would be returned from the scene intersection test
+        /// @param object Hit object, or nullptr on miss
+        /// @param normal Surface normal at the hit
+        /// @param barycentrics Barycentric coordinates of the hit triangle
+        /// @return Surface uvs if they are rendered as the object's material, or the surface normal otherwise
+        glm::vec3 GetSurfaceAttributes(const yart::RenderObject* object, const glm::vec3& normal, const glm::vec2& barycentrics) const;
+
+        /// @brief Complete the first frame of a view rendered from the history, i.e. reprojected, sparsely updated, reshaded or recomposited
+        /// @param rendered Whether the frame has been rendered, or `false` if it has been cancelled
+        /// @param buffer Output buffer, into which the framebuffer is resolved
+        /// @return Whether the frame has been written to the output buffer
+        bool FinishHistoryFrame(bool rendered, float buffer[]);
+
+        /// @brief Write the single sample of a pixel in the first frame of a view rendered from the history into the framebuffer
+        /// @param x Horizontal pixel coordinate
+        /// @param y Vertical pixel coordinate
+        /// @param color Color of the pixel
+        void WriteHistoryPixel(uint32_t x, uint32_t y, const glm::vec3& color);
+
+        /// @brief Estimate the noise level of an image tile from its accumulated samples
+        /// @param tile Image tile
+        /// @param samples Number of samples per pixel accumulated in the tile
+        /// @return Largest relative standard error of the mean luminance across the tile pixels
+        float EstimateTileError(const yart::threads::Tile& tile, uint32_t samples) const;
+
+        /// @brief Trace a packet of primary rays with a specified number of max bounces and store the results in HitPayload structures
+        /// @details Primary hits are resolved for the whole packet at once, while shading and secondary rays are traced individually
+        /// @param camera YART camera instance, from which to trace the rays
+        /// @param packet Traced packet of rays
+        /// @param pixels Array of size `packet.count` with the linear index of the pixel each ray is traced through, 
+        ///     used for compositing the cached overlays layer
+        /// @param payloads Array of HitPayload structures of size `packet.count`, where the ray tracing results will be stored
+        /// @param bounces Max number of bounces
+        void TracePacket(yart::Camera& camera, const yart::RayPacket& packet, const uint32_t pixels[], HitPayload payloads[], uint8_t bounces);
+
+        /// @brief Continue tracing a primary ray, whose closest scene intersection has already been resolved, with a specified number of max bounces
         /// @param camera YART camera instance, from which to trace the rays
         /// @param ray Traced ray
-        /// @param payload HitPayload structure, where the ray tracing results will be stored
+        /// @param surface Surface normal or uvs of the primary hit, as returned from the scene intersection test
+        /// @param pixel Linear index of the pixel the ray is traced through, used for compositing the cached overlays layer
+        /// @param payload HitPayload structure with the primary hit distance and object set, where the ray tracing results will be stored
         /// @param bounces Max number of bounces
-        void TraceRay(yart::Camera& camera, const yart::Ray& ray, HitPayload& payload, uint8_t bounces);
+        void TraceRay(yart::Camera& camera, const yart::Ray& ray, const glm::vec3& surface, size_t pixel, HitPayload& payload, uint8_t bounces);
 
         /// @brief Shoot a single ray into the scene and store the results in a HitPayload structure
         /// @param near Near clipping plane distance
@@ -83,6 +375,22 @@ namespace yart
         /// @return Whether the ray has hit an object on it's path. Used for terminating reflection bounces
         bool TraceRaySingle(float near, float far, const yart::Ray& ray, HitPayload& payload);
 
+        /// @brief Shade the scene intersection of a ray, stored in a HitPayload structure
+        /// @param near Near clipping plane distance
+        /// @param far Far clipping plane distance
+        /// @param ray Traced ray
+        /// @param surface Surface normal or uvs of the hit, as returned from the scene intersection test
+        /// @param payload HitPayload structure with the hit distance and object set, where the shading results will be stored
+        /// @return Whether the ray has hit an object on it's path. Used for terminating reflection bounces
+        bool ShadeHit(float near, float far, const yart::Ray& ray, const glm::vec3& surface, HitPayload& payload);
+
+        /// @brief Sample the overlays/gizmos through the center of each pixel into the cached overlays layer
+        /// @param camera YART camera instance, from which perspective to render
+        /// @param ray_directions Camera ray directions cache, as returned from Camera::GetRayDirections()
+        /// @param width Width in pixels of the output image
+        /// @param height Height in pixels of the output image
+        void UpdateOverlayLayer(const yart::Camera& camera, const glm::vec3* ray_directions, uint32_t width, uint32_t height);
+
         /// @brief Sample the overlays/gizmos layer from a given ray
         /// @param ray Traced ray
         /// @param color Output parameter set to the color at the hit point, or a transparent color on miss
@@ -99,15 +407,88 @@ namespace yart
         /// @param payload HitPayload structure, where the ray tracing results will be stored
         void Miss(const yart::Ray& ray, HitPayload& payload);
 
+    public:
+        static constexpr uint32_t MAX_ACCUMULATED_FRAMES = 256; ///< Number of samples per pixel, after which progressive rendering stops
+
     private:
-        std::unique_ptr<yart::World> m_world = std::make_unique<World>();
+        static constexpr uint32_t ADAPTIVE_MIN_FRAMES = 16; ///< Number of samples per pixel taken before a tile can be considered converged
+        static constexpr float ADAPTIVE_ERROR_THRESHOLD = 0.004f; ///< Relative error estimate, below which a tile is considered converged
+        static constexpr uint32_t PREVIEW_MAX_STRIDE = 8; ///< Largest block size in pixels of the coarse preview frames
+        static constexpr float PREVIEW_TIME_BUDGET = 1.0f / 60.0f; ///< Time in seconds, within which the first preview frame after a reset should render
+        static constexpr uint32_t PACKET_SIZE = 4; ///< Width and height in pixels of the square pixel blocks traced as ray packets
+        static_assert(PACKET_SIZE * PACKET_SIZE <= yart::RayPacket::SIZE, "Pixel blocks must fit in a single ray packet");
+        static_assert(yart::Framebuffer::TILE_SIZE % PACKET_SIZE == 0, "Framebuffer tiles must split evenly into pixel blocks");
+
+        static_assert(((yart::Framebuffer::TILE_SIZE / PACKET_SIZE) & (yart::Framebuffer::TILE_SIZE / PACKET_SIZE - 1)) == 0, 
+            "Pixel blocks are walked in Z-order, so a tile must be a power-of-two number of blocks wide");
+
+        /// @brief Number of pixel blocks in a single framebuffer tile
+        static constexpr uint32_t BLOCKS_PER_TILE = (yart::Framebuffer::TILE_SIZE / PACKET_SIZE) * (yart::Framebuffer::TILE_SIZE / PACKET_SIZE);
+
+        static constexpr float AMBIENT_STRENGTH = 0.03f; ///< Scale of the world's ambient color added to all surfaces
+
+        std::unique_ptr<yart::World> m_world = std::make_unique<World>(); ///< World edited by the UI thread
+        yart::World m_renderWorld; ///< Copy of the world of the frame being rendered, owned by the render thread
+        RenderSettings m_renderSettings; ///< Copy of the render settings of the frame being rendered, owned by the render thread
+        yart::Framebuffer m_framebuffer; ///< Internal tiled render target holding the mean of all accumulated samples, resolved into the output buffer at the end of each frame
+        uint32_t m_accumulatedFrames = 0; ///< Number of samples per pixel accumulated in the framebuffer
+        std::vector<float> m_sampleMoments; ///< Per-pixel mean of squared sample luminances, stored in the framebuffer's tiled pixel order
+        std::vector<uint8_t> m_tileConverged; ///< Per-tile flags, set once a framebuffer tile has converged and stops receiving samples
+        float m_fullFrameTime = 0.0f; ///< Duration in seconds of the latest first frame rendered at full resolution after a reset
+        uint32_t m_previewInitialStride = 1; ///< Block size of the first preview frame since the last reset, or 1 if the view is not previewed
+        uint32_t m_previewStride = 1; ///< Block size of the next preview frame, or 1 once the preview is done and samples are accumulated
+
+        std::vector<OverlaySample> m_overlayLayer; ///< Per-pixel overlays, composited over the primary rays of all frames of the same view
+        bool m_overlayLayerValid = false; ///< Whether the overlays layer has been sampled for the current image size
+        glm::vec3 m_overlayCameraPosition; ///< Camera position the overlays layer has been sampled from
+        glm::vec3 m_overlayCameraDirection; ///< Camera look direction the overlays layer has been sampled with
+        float m_overlayCameraFOV = 0.0f; ///< Camera field of view the overlays layer has been sampled with
+        float m_overlayNearClippingPlane = 0.0f; ///< Camera near clipping plane distance the overlays layer has been sampled with
+        bool m_overlayThickerGrid = false; ///< Grid outline setting the overlays layer has been sampled with
+
+        yart::RenderHistory m_history; ///< Rays traced through the pixel centers of the history view, reused by the first frames of the following views
+        uint32_t m_reprojectedFrames = 0; ///< Number of reprojected frames rendered, selecting the pixels refreshed in each of them
+        std::vector<ObjectEdit> m_objectEdits; ///< Objects changed by the scene snapshot being sparsely updated
+        bool m_editsChangeGeometry = false; ///< Whether the geometry of any of the objects in `m_objectEdits` has changed
+        bool m_framePartial = false; ///< Whether the latest rendered frame has traced only some of its pixels
         std::shared_ptr<yart::Scene> m_scene;
+        std::shared_ptr<const yart::RenderScene> m_renderScene; ///< Scene snapshot used for rendering, replaced with the snapshot of the frame at the start of each frame
+        std::shared_ptr<const yart::RenderScene> m_frameScene; ///< Scene snapshot of the frame being rendered, taken over from the latest frame request
+
+        std::thread m_renderThread; ///< Dedicated thread rendering requested frames, started on the first frame request
+        std::mutex m_renderMutex; ///< Mutex guarding the frame request shared with the render thread
+        std::condition_variable m_renderCondition; ///< Condition variable on which the render thread waits for frame requests
+        bool m_renderThreadShouldStop = false; ///< Whether the render thread should exit
+
+        bool m_frameRequested = false; ///< Whether a new frame has been requested since the render thread last started one
+        bool m_frameResetRequested = false; ///< Whether the accumulated samples should be discarded before the next frame
+        yart::Camera m_requestedCamera; ///< View of the latest frame request
+        std::shared_ptr<const yart::RenderScene> m_requestedScene; ///< Latest published scene snapshot at the time of the latest frame request
+        yart::World m_requestedWorld; ///< Copy of the world of the latest frame request
+        RenderSettings m_requestedSettings; ///< Copy of the render settings of the latest frame request
+        uint32_t m_requestedWidth = 0; ///< Rendered image width of the latest frame request
+        uint32_t m_requestedHeight = 0; ///< Rendered image height of the latest frame request
+        uint32_t m_requestedOutputWidth = 0; ///< Output image width of the latest frame request
+        uint32_t m_requestedOutputHeight = 0; ///< Output image height of the latest frame request
+        yart::threads::CancellationToken m_frameCancellation; ///< Token cancelling the frame in flight, once a newer request has made it obsolete
+        uint32_t m_inFlightWidth = 0; ///< Rendered image width of the frame in flight
+        uint32_t m_inFlightHeight = 0; ///< Rendered image height of the frame in flight
+        uint32_t m_inFlightOutputWidth = 0; ///< Output image width of the frame in flight
+        uint32_t m_inFlightOutputHeight = 0; ///< Output image height of the frame in flight
+        bool m_inFlightRefines = false; ///< Whether the frame in flight adds samples to an already rendered view, rather than rendering its first sample
+        yart::Camera m_renderCamera; ///< Camera owned by the render thread, holding the view and ray directions cache of the frame being rendered
+
+        yart::threads::TripleBuffer<FrameImage> m_frameImages; ///< Lock-free exchange of completed frames from the render thread to the UI thread
+        yart::Upscaler m_upscaler; ///< Upscaler of renders smaller than the requested output image, used by the render thread
+        yart::Camera m_upscaleCamera; ///< Copy of the render camera's view, holding the ray directions cache at the output resolution
+        std::vector<float> m_upscaleSource; ///< Image rendered at the lower resolution, before being upscaled into the output frame
+        bool m_upscaleGuidesOutdated = true; ///< Whether the upscaler guides need to be discarded, set whenever the accumulation is reset
+
+        uint32_t m_presentedFrameSamples = 0; ///< Number of samples per pixel accumulated in the latest presented frame
+        float m_presentedFrameTime = 0.0f; ///< Render time in seconds of the latest presented frame
+        bool m_presentedFramePartial = false; ///< Whether the latest presented frame has traced only some of its pixels
 
-        bool m_showOverlays = true; // Whether the overlays layer should be rendered
-        bool m_useThickerGrid = false; // Whether the overlay grid should use a thicker outline
-        bool m_debugShading = false; // Whether to render the surface uvs or normals as the object's material 
-        bool m_materialUvs = false; // Whether to render the surface uvs as the object's material when `m_debugShading` is true
-        bool m_shadows = true; // Whether to cast and render surface shadows
+        RenderSettings m_settings; ///< Render settings edited by the UI thread
 
 
         // -- FRIEND DECLARATIONS -- //
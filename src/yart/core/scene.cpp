@@ -6,8 +6,6 @@
 #include "scene.h"
 
 
-#include <limits>
-
 #include "yart/common/utils/yart_utils.h"
 
 
@@ -113,71 +111,58 @@ namespace yart
         m_selectedObject = m_selectedObject == object ? nullptr : object;
     }
 
-    float Scene::IntersectRay(const Ray& ray, Object** hit_obj, bool uv, glm::vec3& out)
+    bool Scene::Publish()
     {
-        static constexpr float infinity = std::numeric_limits<float>::infinity();
-        float min_dist = infinity;
+        std::vector<RenderObject> objects;
+        objects.reserve(m_objects.size());
 
         for (auto&& obj : m_objects) {
+            // Transformed meshes re-bake their world-space triangles into a new buffer, as the old one may still be used by published snapshots. 
+            // Meshes whose transform is unchanged, e.g. after a material edit, keep sharing their triangles with the previous version
+            if (obj.m_type == ObjectType::MESH && obj.ShouldBakeWorldTriangles())
+                obj.BakeWorldTriangles();
+
+            const glm::mat4 transformation = obj.GetTransformationMatrix();
+
+            RenderObject render_object = { };
+            render_object.id = obj.m_id;
+            render_object.type = obj.m_type;
+            render_object.position = transformation[3];
+            render_object.inverseScale = 1.0f / glm::vec3(transformation[0][0], transformation[1][1], transformation[2][2]);
+            render_object.materialColor = obj.materialColor;
+            render_object.materialDiffuse = obj.materialDiffuse;
+            render_object.materialSpecular = obj.materialSpecular;
+            render_object.materialSpecularFalloff = obj.materialSpecularFalloff;
+            render_object.materialReflection = obj.materialReflection;
+
             switch (obj.m_type) {
-            case ObjectType::MESH: {
-                glm::mat4 transformation = obj.GetTransformationMatrix();
-
-                for (size_t i = 0; i < obj.tris.size(); ++i) {
-                    const glm::vec3 v0 = transformation * glm::vec4(obj.verts[obj.tris[i].x], 1.0f);
-                    const glm::vec3 v1 = transformation * glm::vec4(obj.verts[obj.tris[i].y], 1.0f);
-                    const glm::vec3 v2 = transformation * glm::vec4(obj.verts[obj.tris[i].z], 1.0f);
-
-                    float t, u, v;
-                    if (yart::Ray::IntersectTriangle(ray, v0, v1, v2, &t, &u, &v) && t > 0.0f && t < min_dist) {
-                        *hit_obj = &obj;
-                        min_dist = t;
-
-                        if (uv) {
-                            // const float w = 1 - (*u) - (*v);
-                            // const glm::u32vec3& uv_indices = obj.triangleUVs[i];
-                            // const glm::vec2 tex_uv = w * obj.UVs[uv_indices.x] + (*u) * obj.UVs[uv_indices.y] + (*v) * obj.UVs[uv_indices.z];
-                            out.x = u;
-                            out.y = v;
-                            out.z = 0.0f;
-                        } else {
-                            // Calculate the surface's normal vector
-                            out = glm::normalize(glm::cross(v1 - v0, v2 - v1));
-                        }
-                    }
-                }
-                break;
-            }
-            case ObjectType::SDF: {
-                const glm::vec3 pos = obj.position;
-                const float radius = obj.m_sdfData.radius * obj.scale.x;
-                glm::vec3 dir = ray.origin - pos; 
-                const float dir_len = glm::length(dir);
-
-                const float a = 1.0f;
-                const float half_b = glm::dot(dir, ray.direction);
-                const float c = dir_len * dir_len - radius * radius;
-                const float discriminant = half_b * half_b - a * c;
-
-                if (discriminant < 0) {
-                    break;
-                }
-
-                const float dist = -half_b - glm::sqrt(discriminant);
-                if (dist > 0.0f && dist < min_dist) {
-                    *hit_obj = &obj;
-                    min_dist = dist;
-
-                    const glm::vec3 hit_pos = ray.origin + dist * ray.direction;
-                    out = glm::normalize(hit_pos - pos);
-                }
+            case ObjectType::MESH:
+                if (obj.m_meshBVH->IsEmpty())
+                    continue;
 
+                render_object.meshBVH = obj.m_meshBVH;
+                render_object.worldTriangles = obj.m_worldTriangles;
                 break;
+            case ObjectType::SDF:
+                render_object.radius = obj.m_sdfData.radius * obj.scale.x;
+                break;
+            default:
+                continue;
             }
-            }
+
+            objects.push_back(std::move(render_object));
         }
 
-        return min_dist == infinity ? -1.0f : min_dist;
+        // Unchanged scenes keep their current version, so that frames accumulated from it stay valid
+        const std::shared_ptr<const RenderScene> previous = std::atomic_load(&m_renderScene);
+        if (previous != nullptr && previous->HasSameObjects(objects))
+            return false;
+
+        const uint64_t version = previous != nullptr ? previous->GetVersion() + 1 : 0;
+        std::shared_ptr<const RenderScene> render_scene = std::make_shared<const RenderScene>(std::move(objects), version, previous.get());
+        std::atomic_store(&m_renderScene, std::move(render_scene));
+
+        return true;
     }
 
     Object* Scene::AddMeshObject(const char* name, Mesh* mesh)
@@ -200,6 +185,7 @@ namespace yart
         // object.triangleUVs = { mesh->triangleVerticesUvs, mesh->triangleVerticesUvs + mesh->trianglesCount };
 
         Object* p_object = &m_objects.emplace_back(object);
+        p_object->BuildMeshBVH();
         ObjectAssignCollection(p_object);
 
         return p_object;
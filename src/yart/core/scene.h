@@ -7,13 +7,14 @@
 
 
 #include <vector>
+#include <memory>
 #include <list>
 
 #include <glm/glm.hpp>
 
 #include "yart/common/mesh_factory.h"
+#include "render_scene.h"
 #include "object.h"
-#include "ray.h"
 
 
 namespace yart
@@ -85,13 +86,21 @@ namespace yart
         /// @param object Object instance, or `nullptr` to deselect all
         void ToggleSelection(Object* object);
 
-        /// @brief Test for ray-scene intersections
-        /// @param ray Ray to be intersected with the scene 
-        /// @param hit_obj Pointer to the nearest hit object, or `nullptr` on miss
-        /// @param uv Wether uv coordinates should be returned instead of the surface normal
-        /// @param out Output parameter set with either the surface normal or uvs
-        /// @return Distance to the closest object hit, or a negative value on miss 
-        float IntersectRay(const Ray& ray, Object** hit_obj, bool uv, glm::vec3& out);
+        /// @brief Compile the current state of the scene into a new version of its immutable RenderScene snapshot, and make it the published one
+        /// @details Should be called from the editing thread, after changes to the scene have been made. 
+        ///     World-space triangles of transformed meshes are re-baked here, other object data is only copied.
+        ///     Any parts of the previous version left untouched by the edits are shared with the new one
+        /// @return Whether the scene has changed since the last call, and a new version has been published
+        bool Publish();
+
+        /// @brief Get the latest published scene snapshot
+        /// @details Safe to call from any thread, concurrently with Scene::Publish(). 
+        ///     The returned snapshot stays valid for as long as the caller holds a reference to it
+        /// @return Scene snapshot, or `nullptr` if the scene has not been published yet
+        std::shared_ptr<const RenderScene> GetRenderScene() const
+        {
+            return std::atomic_load(&m_renderScene);
+        }
 
         /// @brief Add a new mesh type object to the scene 
         /// @param name Name of the object
@@ -129,5 +138,7 @@ namespace yart
         SceneCollection* m_selectedCollection = nullptr; ///< Currently selected scene collection, or `nullptr` if none  
         Object* m_selectedObject = nullptr; ///< Currently selected object in the scene, or `nullptr` if none  
 
+        std::shared_ptr<const RenderScene> m_renderScene; ///< Latest published scene snapshot, accessed atomically
+
     };
 } // namespace yart
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the TriangleSoA structure-of-arrays triangle storage
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+
+namespace yart
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Structure-of-arrays storage of triangles, precomputed for ray intersection tests
+    /// @details Each triangle is stored as its first vertex, two edge vectors and a unit face normal,
+    ///     with every vector component kept in a separate contiguous array. Arrays are over-allocated by
+    ///     TriangleSoA::PADDING zeroed (degenerate) triangles, so that vectorized kernels can always load full blocks
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct TriangleSoA {
+    public:
+        /// @brief Get the number of triangles in the storage
+        /// @return Triangle count
+        uint32_t Size() const
+        {
+            return m_count;
+        }
+
+        /// @brief Resize the storage to hold a given number of triangles
+        /// @param count New triangle count
+        void Resize(uint32_t count)
+        {
+            m_count = count;
+            for (int axis = 0; axis < 3; ++axis) {
+                v0[axis].assign(count + PADDING, 0.0f);
+                edge1[axis].assign(count + PADDING, 0.0f);
+                edge2[axis].assign(count + PADDING, 0.0f);
+                normal[axis].assign(count + PADDING, 0.0f);
+            }
+        }
+
+        /// @brief Precompute and store a triangle at a given index
+        /// @param i Index of the triangle in the storage
+        /// @param p0 First vertex of the triangle
+        /// @param p1 Second vertex of the triangle
+        /// @param p2 Third vertex of the triangle
+        void Set(uint32_t i, const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2)
+        {
+            const glm::vec3 e1 = p1 - p0;
+            const glm::vec3 e2 = p2 - p0;
+            const glm::vec3 n = glm::normalize(glm::cross(e1, e2));
+
+            for (int axis = 0; axis < 3; ++axis) {
+                v0[axis][i] = p0[axis];
+                edge1[axis][i] = e1[axis];
+                edge2[axis][i] = e2[axis];
+                normal[axis][i] = n[axis];
+            }
+        }
+
+        /// @brief Get the first vertex of a stored triangle
+        /// @param i Index of the triangle in the storage
+        /// @return Vertex position
+        glm::vec3 GetVertex0(uint32_t i) const
+        {
+            return { v0[0][i], v0[1][i], v0[2][i] };
+        }
+
+        /// @brief Get the first edge vector (`v1 - v0`) of a stored triangle
+        /// @param i Index of the triangle in the storage
+        /// @return Edge vector
+        glm::vec3 GetEdge1(uint32_t i) const
+        {
+            return { edge1[0][i], edge1[1][i], edge1[2][i] };
+        }
+
+        /// @brief Get the second edge vector (`v2 - v0`) of a stored triangle
+        /// @param i Index of the triangle in the storage
+        /// @return Edge vector
+        glm::vec3 GetEdge2(uint32_t i) const
+        {
+            return { edge2[0][i], edge2[1][i], edge2[2][i] };
+        }
+
+        /// @brief Get the unit face normal of a stored triangle
+        /// @param i Index of the triangle in the storage
+        /// @return Normal vector
+        glm::vec3 GetNormal(uint32_t i) const
+        {
+            return { normal[0][i], normal[1][i], normal[2][i] };
+        }
+
+    public:
+        static constexpr uint32_t PADDING = 7; ///< Number of trailing degenerate triangles, allowing 8-wide loads starting at any valid index
+
+        std::vector<float> v0[3]; ///< First triangle vertex, one array per component
+        std::vector<float> edge1[3]; ///< First triangle edge (`v1 - v0`), one array per component
+        std::vector<float> edge2[3]; ///< Second triangle edge (`v2 - v0`), one array per component
+        std::vector<float> normal[3]; ///< Unit face normal, one array per component
+
+    private:
+        uint32_t m_count = 0; ///< Number of stored triangles, excluding padding
+
+    };
+} // namespace yart
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Implementation of the Upscaler class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "upscaler.h"
+
+
+#include <algorithm>
+
+#include "yart/common/threads/parallel_for.h"
+#include "yart/common/utils/yart_utils.h"
+
+
+namespace yart
+{
+    void Upscaler::UpdateGuides(const yart::RenderScene& scene, yart::Camera& camera, uint32_t width, uint32_t height,
+        yart::Camera& output_camera, uint32_t output_width, uint32_t output_height)
+    {
+        TraceGuides(scene, camera, width, height, m_guides);
+        TraceGuides(scene, output_camera, output_width, output_height, m_outputGuides);
+    }
+
+    void Upscaler::Upscale(const float image[], uint32_t width, uint32_t height, float output[], uint32_t output_width, uint32_t output_height) const
+    {
+        YART_ASSERT(width > 0 && height > 0);
+
+        static constexpr uint32_t channels = 4;
+        const bool guided = HasGuides(width, height, output_width, output_height);
+        const float scale_x = static_cast<float>(width) / static_cast<float>(output_width);
+        const float scale_y = static_cast<float>(height) / static_cast<float>(output_height);
+
+        yart::threads::parallel_for_2d_blocked(output_width, output_height, TILE_SIZE, [&](const yart::threads::Tile& tile) {
+            for (uint32_t y = tile.y0; y < tile.y1; ++y) {
+                for (uint32_t x = tile.x0; x < tile.x1; ++x) {
+                    const size_t index = static_cast<size_t>(y) * output_width + x;
+                    const float depth = guided ? m_outputGuides.depths[index] : 0.0f;
+                    const glm::vec3 normal = guided ? m_outputGuides.normals[index] : glm::vec3(0.0f);
+
+                    // Position of the output pixel center in the rendered image, relative to the centers of its 2x2 nearest rendered pixels
+                    const float u = (static_cast<float>(x) + 0.5f) * scale_x - 0.5f;
+                    const float v = (static_cast<float>(y) + 0.5f) * scale_y - 0.5f;
+                    const int x0 = static_cast<int>(glm::floor(u));
+                    const int y0 = static_cast<int>(glm::floor(v));
+                    const float fx = u - static_cast<float>(x0);
+                    const float fy = v - static_cast<float>(y0);
+
+                    glm::vec4 color = { 0.0f, 0.0f, 0.0f, 0.0f };
+                    float total_weight = 0.0f;
+
+                    size_t best_sample = 0;
+                    float best_range = -1.0f, best_spatial = -1.0f;
+
+                    for (int j = 0; j < 2; ++j) {
+                        for (int i = 0; i < 2; ++i) {
+                            const uint32_t sx = static_cast<uint32_t>(glm::clamp(x0 + i, 0, static_cast<int>(width) - 1));
+                            const uint32_t sy = static_cast<uint32_t>(glm::clamp(y0 + j, 0, static_cast<int>(height) - 1));
+                            const size_t sample = static_cast<size_t>(sy) * width + sx;
+
+                            // Bilinear weight, attenuated by the guides' similarity
+                            const float spatial = (i ? fx : 1.0f - fx) * (j ? fy : 1.0f - fy);
+                            const float range = guided ? GuideWeight(depth, normal, m_guides.depths[sample], m_guides.normals[sample]) : 1.0f;
+                            const float weight = spatial * range;
+
+                            const float* pixel = image + sample * channels;
+                            color += weight * glm::vec4(pixel[0], pixel[1], pixel[2], pixel[3]);
+                            total_weight += weight;
+
+                            if (range > best_range || (range == best_range && spatial > best_spatial)) {
+                                best_sample = sample;
+                                best_range = range;
+                                best_spatial = spatial;
+                            }
+                        }
+                    }
+
+                    // Thin features might not be covered by any of the nearest rendered pixels, which leaves the best matching one
+                    float* out = output + index * channels;
+                    if (total_weight > 1e-4f) {
+                        color /= total_weight;
+                        out[0] = color.r;
+                        out[1] = color.g;
+                        out[2] = color.b;
+                        out[3] = color.a;
+                    } else {
+                        std::copy_n(image + best_sample * channels, channels, out);
+                    }
+                }
+            }
+        });
+    }
+
+    void Upscaler::TraceGuides(const yart::RenderScene& scene, yart::Camera& camera, uint32_t width, uint32_t height, GuideImage& guides)
+    {
+        const glm::vec3* ray_directions = camera.GetRayDirections(width, height);
+        const float near = camera.GetNearClippingPlane();
+        const float far = camera.GetFarClippingPlane();
+
+        guides.width = width;
+        guides.height = height;
+        guides.depths.resize(static_cast<size_t>(width) * height);
+        guides.normals.resize(static_cast<size_t>(width) * height);
+
+        yart::threads::parallel_for_2d_blocked(width, height, TILE_SIZE, [&](const yart::threads::Tile& tile) {
+            for (uint32_t by = tile.y0; by < tile.y1; by += BLOCK_SIZE) {
+                for (uint32_t bx = tile.x0; bx < tile.x1; bx += BLOCK_SIZE) {
+                    const uint32_t x1 = std::min(bx + BLOCK_SIZE, tile.x1);
+                    const uint32_t y1 = std::min(by + BLOCK_SIZE, tile.y1);
+
+                    yart::RayPacket packet;
+                    for (uint32_t y = by; y < y1; ++y) {
+                        for (uint32_t x = bx; x < x1; ++x) {
+                            const size_t i = static_cast<size_t>(y) * width + x;
+                            packet.rays[packet.count++] = { camera.position, ray_directions[i], ray_directions[i + 1], ray_directions[i + width] };
+                        }
+                    }
+
+                    const yart::RenderObject* hit_objects[yart::RayPacket::SIZE];
+                    glm::vec3 normals[yart::RayPacket::SIZE];
+                    float distances[yart::RayPacket::SIZE];
+                    scene.IntersectPacket(packet, hit_objects, false, normals, distances, far);
+
+                    uint32_t r = 0;
+                    for (uint32_t y = by; y < y1; ++y) {
+                        for (uint32_t x = bx; x < x1; ++x, ++r) {
+                            const size_t i = static_cast<size_t>(y) * width + x;
+                            const bool hit = hit_objects[r] != nullptr && distances[r] >= near;
+
+                            guides.depths[i] = hit ? distances[r] : -1.0f;
+                            guides.normals[i] = hit ? normals[r] : glm::vec3(0.0f);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    float Upscaler::GuideWeight(float depth, const glm::vec3& normal, float sample_depth, const glm::vec3& sample_normal)
+    {
+        // Pixels missing the scene only match other misses
+        if (depth < 0.0f || sample_depth < 0.0f)
+            return (depth < 0.0f && sample_depth < 0.0f) ? 1.0f : 0.0f;
+
+        const float depth_difference = (depth - sample_depth) / (DEPTH_TOLERANCE * depth);
+        const float depth_weight = glm::exp(-depth_difference * depth_difference);
+        const float normal_weight = glm::pow(glm::max(glm::dot(normal, sample_normal), 0.0f), NORMAL_EXPONENT);
+
+        return depth_weight * normal_weight;
+    }
+} // namespace yart
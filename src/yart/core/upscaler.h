@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file
+/// @brief Definition of the Upscaler class
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "yart/core/render_scene.h"
+#include "yart/core/camera.h"
+
+
+namespace yart
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Edge-aware upscaler, reconstructing full resolution images from renders at a lower resolution
+    /// @details Implements joint bilateral upsampling, guided by the depth and surface normal of the primary hits. Guides are
+    ///     traced at both the rendered and the output resolution, which only takes primary visibility rays, without any shading.
+    ///     Each output pixel interpolates its nearest rendered pixels, weighted by how closely their guides match its own,
+    ///     so that colors are smoothly interpolated across surfaces without bleeding over object edges.
+    ///     Images upscaled without matching guides are interpolated bilinearly
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    class Upscaler {
+    public:
+        /// @brief Trace the guides of a view at the rendered and the output resolution
+        /// @note Guides depend on the view and the scene geometry, so they should be updated whenever either of them changes
+        /// @param scene Rendered scene snapshot
+        /// @param camera Camera of the rendered view, used for tracing the guides at the rendered resolution
+        /// @param width Width in pixels of the rendered image
+        /// @param height Height in pixels of the rendered image
+        /// @param output_camera Camera with the same view as `camera`, used for tracing the guides at the output resolution.
+        ///     Kept separate so that neither camera has to recalculate its ray directions cache on each update
+        /// @param output_width Width in pixels of the output image
+        /// @param output_height Height in pixels of the output image
+        void UpdateGuides(const yart::RenderScene& scene, yart::Camera& camera, uint32_t width, uint32_t height,
+            yart::Camera& output_camera, uint32_t output_width, uint32_t output_height);
+
+        /// @brief Discard the guides, e.g. after the view or the scene geometry has changed
+        void DiscardGuides()
+        {
+            m_guides.width = m_guides.height = 0;
+            m_outputGuides.width = m_outputGuides.height = 0;
+        }
+
+        /// @brief Check whether the upscaler holds guides for given image sizes
+        /// @param width Width in pixels of the rendered image
+        /// @param height Height in pixels of the rendered image
+        /// @param output_width Width in pixels of the output image
+        /// @param output_height Height in pixels of the output image
+        /// @return Whether the guides were last updated for the same sizes
+        bool HasGuides(uint32_t width, uint32_t height, uint32_t output_width, uint32_t output_height) const
+        {
+            return m_guides.width == width && m_guides.height == height
+                && m_outputGuides.width == output_width && m_outputGuides.height == output_height;
+        }
+
+        /// @brief Upscale a rendered image to the output resolution
+        /// @details Guides updated with Upscaler::UpdateGuides() for the same image sizes are used for edge-aware interpolation. 
+        ///     Without them, the image is interpolated bilinearly
+        /// @param image Linear, row-major RGBA pixel array at the rendered resolution
+        /// @param width Width in pixels of the rendered image
+        /// @param height Height in pixels of the rendered image
+        /// @param output Output linear, row-major RGBA pixel array at the output resolution
+        /// @param output_width Width in pixels of the output image
+        /// @param output_height Height in pixels of the output image
+        void Upscale(const float image[], uint32_t width, uint32_t height, float output[], uint32_t output_width, uint32_t output_height) const;
+
+    private:
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Per-pixel primary hit attributes of a view, stored in linear, row-major order
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct GuideImage {
+            uint32_t width = 0; ///< Width in pixels of the guide image
+            uint32_t height = 0; ///< Height in pixels of the guide image
+            std::vector<float> depths; ///< Distance from the camera to the primary hit of each pixel, or a negative value on miss
+            std::vector<glm::vec3> normals; ///< Surface normal at the primary hit of each pixel
+        };
+
+        /// @brief Trace the primary hits through the pixel centers of a view
+        /// @param scene Rendered scene snapshot
+        /// @param camera Camera of the view
+        /// @param width Width in pixels of the guide image
+        /// @param height Height in pixels of the guide image
+        /// @param guides Output guide image
+        static void TraceGuides(const yart::RenderScene& scene, yart::Camera& camera, uint32_t width, uint32_t height, GuideImage& guides);
+
+        /// @brief Compute the similarity of the primary hits of two pixels
+        /// @param depth Primary hit distance of the first pixel, or a negative value on miss
+        /// @param normal Primary hit surface normal of the first pixel
+        /// @param sample_depth Primary hit distance of the second pixel, or a negative value on miss
+        /// @param sample_normal Primary hit surface normal of the second pixel
+        /// @return Weight in the `[0, 1]` range, close to 1 for pixels likely lying on the same surface
+        static float GuideWeight(float depth, const glm::vec3& normal, float sample_depth, const glm::vec3& sample_normal);
+
+    private:
+        static constexpr uint32_t BLOCK_SIZE = 4; ///< Width and height in pixels of the square pixel blocks traced as ray packets
+        static_assert(BLOCK_SIZE * BLOCK_SIZE <= yart::RayPacket::SIZE, "Pixel blocks must fit in a single ray packet");
+
+        static constexpr uint32_t TILE_SIZE = 32; ///< Width and height in pixels of the image tiles processed in parallel
+        static constexpr float DEPTH_TOLERANCE = 0.1f; ///< Relative hit distance difference, at which the weight of a rendered pixel falls to `1/e`
+        static constexpr float NORMAL_EXPONENT = 16.0f; ///< Exponent applied to the normals' cosine, controlling how fast the weight falls off with their angle
+
+        GuideImage m_guides; ///< Guides at the rendered resolution
+        GuideImage m_outputGuides; ///< Guides at the output resolution
+
+    };
+} // namespace yart
@@ -14,7 +14,7 @@
 namespace yart
 {
     Viewport::Viewport(uint32_t width, uint32_t height)
-        : m_width(width), m_height(height)
+        : m_width(width), m_height(height), m_renderWidth(width), m_renderHeight(height)
     {
         m_image = yart::Backend::CreateImage(width, height, IMAGE_FORMAT, DEFAULT_IMAGE_SAMPLER);
         YART_ASSERT(m_image != nullptr);
@@ -25,8 +25,9 @@ namespace yart
     Viewport::Viewport(uint32_t width, uint32_t height, uint8_t scale)
         : m_width(width), m_height(height), m_imageScale(scale)
     {
-        uint32_t scaled_width = glm::max(m_width / m_imageScale, 1U);
-        uint32_t scaled_height = glm::max(m_height / m_imageScale, 1U);
+        GetScaledImageSize(m_width, m_height, &m_renderWidth, &m_renderHeight);
+        const uint32_t scaled_width = m_renderWidth;
+        const uint32_t scaled_height = m_renderHeight;
 
         m_image = yart::Backend::CreateImage(scaled_width, scaled_height, IMAGE_FORMAT, DEFAULT_IMAGE_SAMPLER);
         YART_ASSERT(m_image != nullptr);
@@ -45,14 +46,19 @@ namespace yart
         m_width = width; 
         m_height = height;
 
-        uint32_t scaled_width = glm::max(width / m_imageScale, 1U);
-        uint32_t scaled_height = glm::max(height / m_imageScale, 1U);
+        GetScaledImageSize(width, height, &m_renderWidth, &m_renderHeight);
+
+        // Upscaled renders are presented in an image of the full viewport size
+        const uint32_t scaled_width = m_upscaling ? glm::max(width, 1U) : m_renderWidth;
+        const uint32_t scaled_height = m_upscaling ? glm::max(height, 1U) : m_renderHeight;
+
         ImVec2 image_size = GetImageSize();
         if (image_size.x == scaled_width && image_size.y == scaled_height)
             return; // When the underlying image is down scaled, scaling the viewport does not necessarily mean the image has to be recreated
 
+        // Cleared, as the renderer might only present a frame of the new size a few frames later
         delete[] m_imageData;
-        m_imageData = new float[scaled_width * scaled_height * m_image->GetFormatChannelsCount()];
+        m_imageData = new float[scaled_width * scaled_height * m_image->GetFormatChannelsCount()]();
 
         m_image->Resize(scaled_width, scaled_height);
         m_needsRefresh = true;
@@ -68,10 +74,51 @@ namespace yart
         m_needsRefresh = true;
     }
 
+    void Viewport::SetUpscalingEnabled(bool upscaling)
+    {
+        if (upscaling == m_upscaling)
+            return;
+
+        m_upscaling = upscaling;
+        m_needsRefresh = true;
+    }
+
+    void Viewport::SetFrameTimeBudget(float budget)
+    {
+        YART_ASSERT(budget >= 0.0f);
+        m_frameTimeBudget = budget;
+
+        if (budget == 0.0f)
+            m_resolutionScale = 1.0f;
+    }
+
+    void Viewport::ReportFrameTime(float frame_time)
+    {
+        static constexpr float tolerance = 0.15f; // Relative deviation from the budget, within which the resolution is kept
+
+        if (m_frameTimeBudget == 0.0f || frame_time <= 0.0f)
+            return;
+
+        const float ratio = m_frameTimeBudget / frame_time;
+        if (ratio > 1.0f - tolerance && ratio < 1.0f + tolerance)
+            return;
+
+        // Render time is roughly proportional to the number of pixels, i.e. the square of the resolution scale
+        m_resolutionScale = glm::clamp(m_resolutionScale * glm::sqrt(ratio), MIN_RESOLUTION_SCALE, 1.0f);
+    }
+
     void Viewport::Refresh()
     {
         m_image->BindData(m_imageData);
         m_needsRefresh = false;
     }
 
+    void Viewport::GetScaledImageSize(uint32_t width, uint32_t height, uint32_t* image_width, uint32_t* image_height) const
+    {
+        const float scale = m_resolutionScale / static_cast<float>(m_imageScale);
+
+        *image_width = glm::max(static_cast<uint32_t>(static_cast<float>(width) * scale), 1U);
+        *image_height = glm::max(static_cast<uint32_t>(static_cast<float>(height) * scale), 1U);
+    }
+
 } // namespace yart
@@ -58,13 +58,58 @@ namespace yart
         /// @param scale New viewport scale-down factor
         void SetImageScale(uint8_t scale);
 
+        /// @brief Get the fractional resolution scale of the underlying image, applied on top of the image scale down factor
+        /// @return Resolution scale in the `[Viewport::MIN_RESOLUTION_SCALE, 1]` range
+        float GetResolutionScale() const
+        {
+            return m_resolutionScale;
+        }
+
+        /// @brief Get the frame time budget targeted by dynamic resolution
+        /// @return Target frame time in seconds, or 0 if dynamic resolution is disabled
+        float GetFrameTimeBudget() const
+        {
+            return m_frameTimeBudget;
+        }
+
+        /// @brief Set the frame time budget targeted by dynamic resolution
+        /// @param budget Target frame time in seconds, or 0 to disable dynamic resolution and restore the full resolution
+        void SetFrameTimeBudget(float budget);
+
+        /// @brief Report the time it took to render a frame at the current image size, adjusting the resolution scale towards the frame time budget
+        /// @details The new resolution is applied on the next call to Viewport::Resize(). Times within a tolerance of the budget are ignored, 
+        ///     so that measurement noise does not keep recreating the image. Does nothing if dynamic resolution is disabled
+        /// @param frame_time Render time in seconds of a frame, representative of the cost of rendering the current image size
+        void ReportFrameTime(float frame_time);
+
         /// @brief Get the current size of the underlying viewport image in pixels
-        /// @return The current size of the scaled viewport image
+        /// @return The current size of the viewport image, scaled unless edge-aware upscaling is enabled
         ImVec2 GetImageSize() const
         {
             return m_image->GetSize();
         }
 
+        /// @brief Get the resolution at which the viewport image should be rendered 
+        /// @return The current size of the scaled viewport image. With edge-aware upscaling enabled, the 
+        ///     rendered image is smaller than the viewport image and should be upscaled to Viewport::GetImageSize()
+        ImVec2 GetRenderSize() const
+        {
+            return { static_cast<float>(m_renderWidth), static_cast<float>(m_renderHeight) };
+        }
+
+        /// @brief Check whether edge-aware upscaling is enabled for the viewport
+        /// @return Whether the viewport image is kept at the full viewport size, instead of being scaled down
+        bool IsUpscalingEnabled() const
+        {
+            return m_upscaling;
+        }
+
+        /// @brief Enable or disable edge-aware upscaling of the viewport image
+        /// @details With upscaling enabled, the image scale down factors only apply to the render resolution, while the 
+        ///     viewport image is kept at full size, to be filled with upscaled renders. The change is applied on the next call to Viewport::Resize()
+        /// @param upscaling Whether upscaling should be enabled
+        void SetUpscalingEnabled(bool upscaling);
+
         /// @brief Get the sampler type currently used by the viewport's image
         /// @return Current image sampler type
         Backend::ImageSampler GetImageSampler() const
@@ -107,6 +152,16 @@ namespace yart
         /// @brief Apply changes made to the image data and update the underlying viewport image
         void Refresh();
 
+        /// @brief Compute the size of the underlying image for a given viewport size, using the current image and resolution scales
+        /// @param width Width of the viewport in pixels
+        /// @param height Height of the viewport in pixels
+        /// @param image_width Output parameter set to the image width in pixels
+        /// @param image_height Output parameter set to the image height in pixels
+        void GetScaledImageSize(uint32_t width, uint32_t height, uint32_t* image_width, uint32_t* image_height) const;
+
+    public:
+        static constexpr float MIN_RESOLUTION_SCALE = 0.25f; ///< Lowest fractional resolution scale dynamic resolution can go down to
+
     private:
         static constexpr yart::Backend::ImageFormat IMAGE_FORMAT = Backend::ImageFormat::R32G32B32A32_FLOAT;
         static constexpr yart::Backend::ImageSampler DEFAULT_IMAGE_SAMPLER = Backend::ImageSampler::NEAREST;
@@ -115,6 +170,11 @@ namespace yart
         uint32_t m_width;  // Width of the viewport in pixels (does not take image scale into account)
         uint32_t m_height; // Height of the viewport in pixels (does not take image scale into account)
         uint8_t m_imageScale = 1; // Should only ever be in the [1, +inf) range
+        float m_resolutionScale = 1.0f; // Fractional scale set by dynamic resolution, in the [MIN_RESOLUTION_SCALE, 1] range
+        float m_frameTimeBudget = 0.0f; // Frame time in seconds targeted by dynamic resolution, or 0 if disabled
+        bool m_upscaling = false; // Whether the image is kept at full size and filled with upscaled renders
+        uint32_t m_renderWidth; // Width of the rendered image in pixels
+        uint32_t m_renderHeight; // Height of the rendered image in pixels
         bool m_needsRefresh = false;
         float* m_imageData = nullptr;
 
@@ -6,6 +6,7 @@
 #pragma once
 
 
+#include <cstddef>
 #include <vector>
 
 #include <glm/glm.hpp>
@@ -16,6 +17,16 @@
 
 namespace yart
 {
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Point light source illuminating the scene
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct PointLight {
+    public:
+        glm::vec3 position; ///< World-space position of the light
+        float intensity; ///< Intensity of the light, attenuated with the squared distance from it
+
+    };
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////
     /// @brief Rendered scene environment definition class
     ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -27,7 +38,14 @@ namespace yart
         glm::vec3 SampleSkyColor(const glm::vec3& direction);
 
     public:
+        static constexpr size_t LIGHT_COUNT = 3; ///< Number of point lights illuminating the scene
+
         glm::vec3 ambientColor = { 0.131f, 0.241f, 0.500f }; ///< World's ambient illumination color
+        PointLight lights[LIGHT_COUNT] = { ///< Point lights illuminating the scene
+            { { -2.0f, 4.0f, -3.0f }, 0.8f }, 
+            { {  2.0f, 1.0f, -2.0f }, 0.5f }, 
+            { { -0.5f, 0.5f, -4.0f }, 0.2f }
+        };
 
     private:
         /// @brief Types of renderable environment skies
@@ -180,14 +180,20 @@ namespace yart
             section_open = GUI::BeginCollapsableSection("Position");
             if (section_open) {
                 static const char* names[3] = { "Position X", "Position Y", "Position Z" };
-                made_changes |= GUI::SliderVec3(names, &selected_object->position);
+                if (GUI::SliderVec3(names, &selected_object->position)) {
+                    selected_object->TransformationChanged();
+                    made_changes = true;
+                }
             }
             GUI::EndCollapsableSection(section_open);
 
             section_open = GUI::BeginCollapsableSection("Scale");
             if (section_open) {
                 static const char* names[3] = { "Scale X", "Scale Y", "Scale Z" };
-                made_changes |= GUI::SliderVec3(names, &selected_object->scale);
+                if (GUI::SliderVec3(names, &selected_object->scale)) {
+                    selected_object->TransformationChanged();
+                    made_changes = true;
+                }
             }
             GUI::EndCollapsableSection(section_open);
 
@@ -219,9 +225,6 @@ namespace yart
             }
             GUI::EndCollapsableSection(section_open);
 
-            if (made_changes)
-                selected_object->TransformationChanged();
-
             return made_changes;
         }
 
@@ -45,6 +45,8 @@ namespace yart
 
             settings.viewportScale = m_viewport.GetImageScale();
             settings.viewportImageSampler = m_viewport.GetImageSampler();
+            settings.viewportFrameTimeBudget = m_viewport.GetFrameTimeBudget();
+            settings.viewportUpscaling = m_viewport.IsUpscalingEnabled();
 
             return settings;
         }
@@ -55,6 +57,8 @@ namespace yart
 
             m_viewport.SetImageScale(settings->viewportScale);
             m_viewport.SetImageSampler(settings->viewportImageSampler);
+            m_viewport.SetFrameTimeBudget(settings->viewportFrameTimeBudget);
+            m_viewport.SetUpscalingEnabled(settings->viewportUpscaling);
         }
 
         bool RenderViewportPanel::HandleInputs(bool* should_refresh_viewports)
@@ -118,14 +122,23 @@ namespace yart
             const ImRect win_rect = window->Rect();
             m_viewport.Resize(win_rect.GetWidth(), win_rect.GetHeight());
 
-            // Ray trace the scene onto the main render viewport image on CPU
+            // Ray trace the scene on CPU, asynchronously on the renderer's dedicated thread. 
+            // Any change made through the interface invalidates the progressively accumulated image
             yart::Renderer* renderer = yart::Application::Get().GetRenderer();
             yart::Camera& camera = RenderViewportPanel::s_camera;
-            const bool viewport_dirty = renderer->Render(camera, m_viewport);
 
-            // Render the viewport image
-            const bool should_refresh = viewport_dirty || ctx->shouldRefreshViewports;
-            ImTextureID viewport_texture = m_viewport.GetImTextureID(should_refresh);
+            const ImVec2 image_size = m_viewport.GetImageSize();
+            const ImVec2 render_size = m_viewport.GetRenderSize();
+            renderer->RequestFrame(camera, render_size.x, render_size.y, image_size.x, image_size.y, ctx->shouldRefreshViewports);
+
+            // Render the latest completed viewport image, without waiting for the requested frame
+            const bool frame_presented = renderer->PresentFrame(m_viewport);
+
+            // The first fully traced sample of a view is what the user waits for after each change, so its cost drives the dynamic resolution
+            if (frame_presented && renderer->GetAccumulatedFrames() == 1 && !renderer->IsPresentedFramePartial())
+                m_viewport.ReportFrameTime(renderer->GetPresentedFrameTime());
+
+            ImTextureID viewport_texture = m_viewport.GetImTextureID(frame_presented);
             ImGui::GetBackgroundDrawList()->AddImage(viewport_texture, win_rect.Min, win_rect.Max);
 
             // Render the camera view axes overlay window
@@ -31,6 +31,8 @@ namespace yart
         public:
             uint8_t viewportScale; ///< Scale of the render viewport
             yart::Backend::ImageSampler viewportImageSampler; ///< Sampler type for the render viewport
+            float viewportFrameTimeBudget; ///< Frame time targeted by the render viewport's dynamic resolution
+            bool viewportUpscaling; ///< Whether the render viewport uses edge-aware upscaling
 
         };
 
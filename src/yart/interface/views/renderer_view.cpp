@@ -46,6 +46,12 @@ namespace yart
             }
             GUI::EndCollapsableSection(section_open);
 
+            section_open = GUI::BeginCollapsableSection("Sampling");
+            if (section_open) {
+                made_changes |= RenderSamplingSection(renderer);
+            }
+            GUI::EndCollapsableSection(section_open);
+
             return made_changes;
         }
 
@@ -53,47 +59,61 @@ namespace yart
         {
             bool made_changes = false;
 
-            made_changes |= GUI::CheckBox("Debug materials", &target->m_debugShading);
+            made_changes |= GUI::CheckBox("Debug materials", &target->m_settings.debugShading);
 
-            if (!target->m_debugShading) 
+            if (!target->m_settings.debugShading) 
                 ImGui::BeginDisabled();
 
             static constexpr size_t materials_count = 2;
             static const char* materials[materials_count] = { "Normals", "UVs" };
-            int selection = static_cast<int>(target->m_materialUvs);
+            int selection = static_cast<int>(target->m_settings.materialUvs);
             if (GUI::ComboHeader("Render material", materials, materials_count, &selection)) {
-                target->m_materialUvs ^= 0x1;
+                target->m_settings.materialUvs ^= 0x1;
                 made_changes = true;
             }
 
-            if (!target->m_debugShading) 
+            if (!target->m_settings.debugShading) 
                 ImGui::EndDisabled();
 
-            made_changes |= GUI::CheckBox("Cast shadows", &target->m_shadows);
+            made_changes |= GUI::CheckBox("Cast shadows", &target->m_settings.shadows);
 
             return made_changes;
         }
 
         bool RendererView::RenderOverlaysSection(yart::Renderer* target)
         {
-            bool made_changes = GUI::CheckBox("Grid", &target->m_showOverlays);
+            bool made_changes = GUI::CheckBox("Grid", &target->m_settings.showOverlays);
 
-            if (!target->m_showOverlays)
+            if (!target->m_settings.showOverlays)
                 ImGui::BeginDisabled();
 
             static constexpr size_t outlines_count = 2;
             static const char* outlines[outlines_count] = { "Normal", "Thick" };
-            int selection = static_cast<int>(target->m_useThickerGrid);
+            int selection = static_cast<int>(target->m_settings.useThickerGrid);
             if (GUI::ComboHeader("Grid outline", outlines, outlines_count, &selection)) {
-                target->m_useThickerGrid ^= 0x1;
+                target->m_settings.useThickerGrid ^= 0x1;
                 made_changes = true;
             }
 
-            if (!target->m_showOverlays)
+            if (!target->m_settings.showOverlays)
                 ImGui::EndDisabled();
 
             return made_changes;
         }
+
+        bool RendererView::RenderSamplingSection(yart::Renderer* target)
+        {
+            bool made_changes = GUI::CheckBox("Adaptive sampling", &target->m_settings.adaptiveSampling);
+            made_changes |= GUI::CheckBox("Progressive preview", &target->m_settings.progressivePreview);
+            made_changes |= GUI::CheckBox("Temporal reprojection", &target->m_settings.temporalReprojection);
+            made_changes |= GUI::CheckBox("Sparse scene updates", &target->m_settings.sparseUpdates);
+            made_changes |= GUI::CheckBox("Deferred shading", &target->m_settings.deferredShading);
+            made_changes |= GUI::CheckBox("Lighting recomposition", &target->m_settings.lightingRecomposition);
+
+            ImGui::Text("Samples: %u/%u", target->GetAccumulatedFrames(), yart::Renderer::MAX_ACCUMULATED_FRAMES);
+
+            return made_changes;
+        }
         
     } // namespace Interface
 } // namespace yart
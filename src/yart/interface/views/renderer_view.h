@@ -56,6 +56,11 @@ namespace yart
             /// @returns Whether any changes were made by the user since the last frame
             static bool RenderOverlaysSection(yart::Renderer* target);
 
+            /// @brief Issue "Sampling" section GUI render commands
+            /// @param target View target instance
+            /// @returns Whether any changes were made by the user since the last frame
+            static bool RenderSamplingSection(yart::Renderer* target);
+
         private:
             static constexpr char* NAME = "Renderer";
             static constexpr char* ICON = ICON_CI_EDIT;
@@ -52,9 +52,9 @@ namespace yart
 
             GUI::BeginMultiItem(2);
             {
-                ImVec2 image_size = target->GetImageSize();
-                GUI::Label("Resolution X", "%dpx", static_cast<uint32_t>(image_size.x));
-                GUI::Label("Y",            "%dpx", static_cast<uint32_t>(image_size.y));
+                ImVec2 render_size = target->GetRenderSize();
+                GUI::Label("Resolution X", "%dpx", static_cast<uint32_t>(render_size.x));
+                GUI::Label("Y",            "%dpx", static_cast<uint32_t>(render_size.y));
             }
             GUI::EndMultiItem();
 
@@ -64,14 +64,41 @@ namespace yart
                 made_changes = true;
             }
 
+            static constexpr size_t budgets_count = 3;
+            static const char* budget_names_LUT[budgets_count] = { "Off",  "16 ms",  "33 ms"  };
+            static constexpr float budgets[budgets_count] =      { 0.0f,   0.016f,   0.033f   };
+
+            int selected_budget = 0;
+            for (size_t i = 0; i < budgets_count; ++i) {
+                if (budgets[i] == target->GetFrameTimeBudget())
+                    selected_budget = static_cast<int>(i);
+            }
+
+            if (GUI::ComboHeader("Dynamic resolution", budget_names_LUT, budgets_count, &selected_budget))
+                target->SetFrameTimeBudget(budgets[selected_budget]);
+
+            if (target->GetFrameTimeBudget() > 0.0f)
+                GUI::Label("Resolution scale", "%d%%", static_cast<int>(target->GetResolutionScale() * 100.0f + 0.5f));
+
             static constexpr size_t samplers_count = 2;
             static const char* sampler_names_LUT[samplers_count] =            { "Nearest",                      "Bilinear"                      };
             static constexpr Backend::ImageSampler samplers[samplers_count] = { Backend::ImageSampler::NEAREST, Backend::ImageSampler::BILINEAR };
 
+            bool upscaling = target->IsUpscalingEnabled();
+            if (GUI::CheckBox("Edge-aware upscaling", &upscaling))
+                target->SetUpscalingEnabled(upscaling);
+
+            // Upscaled images are displayed at their native size, so the sampler has no effect
+            if (upscaling)
+                ImGui::BeginDisabled();
+
             int selected_sampler = (target->GetImageSampler() == samplers[0]) ? 0 : 1;
             if (GUI::ComboHeader("Interpolation", sampler_names_LUT, samplers_count, &selected_sampler))
                 target->SetImageSampler(samplers[selected_sampler]);
 
+            if (upscaling)
+                ImGui::EndDisabled();
+
             return made_changes;
         }
 
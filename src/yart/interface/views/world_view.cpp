@@ -48,6 +48,12 @@ namespace yart
             }
             GUI::EndCollapsableSection(section_open);
 
+            section_open = GUI::BeginCollapsableSection("Lights");
+            if (section_open) {
+                made_changes |= RenderLightsSection(world);
+            }
+            GUI::EndCollapsableSection(section_open);
+
             return made_changes;
         }
 
@@ -134,5 +140,26 @@ namespace yart
             return made_changes;
         }
 
+        bool WorldView::RenderLightsSection(yart::World* target)
+        {
+            bool made_changes = false;
+
+            for (size_t i = 0; i < yart::World::LIGHT_COUNT; ++i) {
+                yart::PointLight& light = target->lights[i];
+
+                // Widgets of all lights share their labels
+                ImGui::PushID(static_cast<int>(i));
+                ImGui::Text("Light %zu", i + 1);
+
+                static const char* names[3] = { "Position X", "Position Y", "Position Z" };
+                made_changes |= GUI::SliderVec3(names, &light.position);
+                made_changes |= GUI::SliderFloat("Intensity", &light.intensity, 0.0f, 2.0f);
+
+                ImGui::PopID();
+            }
+
+            return made_changes;
+        }
+
     } // namespace Interface
 } // namespace yart